@@ -40,8 +40,12 @@
 #include "dbgu.h"
 #include "debug.h"
 #include "sdramc.h"
+#include "dram_timing.h"
+#include "dram_parts.h"
 #include "psram.h"
 #include "at91sam9263ek.h"
+#include "common.h"
+#include "flash.h"
 
 #ifdef CONFIG_USER_HW_INIT
 extern void hw_init_hook(void);
@@ -280,6 +284,8 @@ static void sdramc_hw_init(void)
 	pio_configure(sdramc_pins);
 }
 
+static const struct dram_timing sdram_timing = DRAM_MT48LC16M16A2_75;
+
 static void sdramc0_init(void)
 {
 	unsigned int reg;
@@ -287,19 +293,15 @@ static void sdramc0_init(void)
 
 #ifdef CONFIG_SDRAM_16BIT
 	sdramc_config.cr = AT91C_SDRAMC_NC_10 | AT91C_SDRAMC_NR_13 | AT91C_SDRAMC_CAS_2
-				| AT91C_SDRAMC_NB_4_BANKS | AT91C_SDRAMC_DBW_16_BITS
-				| AT91C_SDRAMC_TWR_2 | AT91C_SDRAMC_TRC_7
-				| AT91C_SDRAMC_TRP_2 | AT91C_SDRAMC_TRCD_2
-				| AT91C_SDRAMC_TRAS_5 | AT91C_SDRAMC_TXSR_8;
+				| AT91C_SDRAMC_NB_4_BANKS | AT91C_SDRAMC_DBW_16_BITS;
 #else
 	sdramc_config.cr = AT91C_SDRAMC_NC_9 | AT91C_SDRAMC_NR_13 | AT91C_SDRAMC_CAS_2
-				| AT91C_SDRAMC_NB_4_BANKS | AT91C_SDRAMC_DBW_32_BITS
-				| AT91C_SDRAMC_TWR_2 | AT91C_SDRAMC_TRC_7
-				| AT91C_SDRAMC_TRP_2 | AT91C_SDRAMC_TRCD_2
-				| AT91C_SDRAMC_TRAS_5 | AT91C_SDRAMC_TXSR_8;
+				| AT91C_SDRAMC_NB_4_BANKS | AT91C_SDRAMC_DBW_32_BITS;
 #endif	/* #ifdef CONFIG_SDRAM_16BIT */
 
-	sdramc_config.tr = (MASTER_CLOCK * 7) / 1000000;
+	/* Hang: the SDRAM can not be run at this MCK, the error is logged */
+	if (sdramc_timing(&sdramc_config, &sdram_timing, MASTER_CLOCK))
+		while (1);
 	sdramc_config.mdr = AT91C_SDRAMC_MD_SDRAM;
 
 	sdramc_hw_init();
@@ -435,6 +437,42 @@ void hw_init(void)
 }
 #endif /* #ifdef CONFIG_HW_INIT */
 
+#ifdef CONFIG_CLOCK_BOOST
+/*
+ * The image was loaded at the boost clock, bring the clocks down to the
+ * production setting before jumping to it. The SMC cycle counts only get
+ * longer at a slower MCK, but the SDRAM refresh count has to shrink.
+ */
+void hw_clock_handoff(void)
+{
+#ifdef CONFIG_DEBUG
+	dbgu_flush();
+#endif
+
+#ifdef CONFIG_SDRAM
+	/* Refresh in time for the slowest MCK seen during the switch */
+	sdramc_set_refresh(DRAM_REFRESH_COUNT(sdram_timing.trefi,
+						BOARD_MAINOSC / 2));
+#endif
+
+	/* Run MCK from the main oscillator while PLLA relocks */
+	pmc_cfg_mck(AT91C_PMC_CSS_MAIN_CLK | MCKR_SETTINGS, PLL_LOCK_TIMEOUT);
+
+	pmc_cfg_plla(FINAL_PLLA_SETTINGS, PLL_LOCK_TIMEOUT);
+
+	pmc_cfg_mck(MCKR_CSS_SETTINGS, PLL_LOCK_TIMEOUT);
+
+#ifdef CONFIG_SDRAM
+	sdramc_set_refresh(DRAM_REFRESH_COUNT(sdram_timing.trefi,
+						FINAL_MASTER_CLOCK));
+#endif
+
+#ifdef CONFIG_DEBUG
+	dbgu_init(BAUDRATE(FINAL_MASTER_CLOCK, 115200));
+#endif
+}
+#endif /* #ifdef CONFIG_CLOCK_BOOST */
+
 #ifdef CONFIG_DATAFLASH
 void at91_spi0_hw_init(void)
 {
@@ -539,3 +577,35 @@ void nandflash_config_buswidth(unsigned char busw)
 	writel(csa, AT91C_BASE_SMC0 + SMC_CTRL3);
 }
 #endif /* #ifdef CONFIG_NANDFLASH */
+
+#ifdef CONFIG_FLASH
+void norflash_hw_init(void)
+{
+	/*
+	 * The 16-bit NOR flash on EBI0 CS0 only uses dedicated pins
+	 * (A1-A22, D0-D15, NCS0, NRD, NWE), only the SMC is set up.
+	 */
+	writel((AT91C_FLASH_NWE_SETUP
+		| AT91C_FLASH_NCS_WR_SETUP
+		| AT91C_FLASH_NRD_SETUP
+		| AT91C_FLASH_NCS_RD_SETUP),
+		AT91C_BASE_SMC0 + SMC_SETUP0);
+
+	writel((AT91C_FLASH_NWE_PULSE
+		| AT91C_FLASH_NCS_WR_PULSE
+		| AT91C_FLASH_NRD_PULSE
+		| AT91C_FLASH_NCS_RD_PULSE),
+		AT91C_BASE_SMC0 + SMC_PULSE0);
+
+	writel((AT91C_FLASH_NWE_CYCLE
+		| AT91C_FLASH_NRD_CYCLE),
+		AT91C_BASE_SMC0 + SMC_CYCLE0);
+
+	writel((AT91C_SMC_READMODE
+		| AT91C_SMC_WRITEMODE
+		| AT91C_SMC_NWAITM_NWAIT_DISABLE
+		| AT91C_SMC_DBW_WIDTH_BITS_16
+		| AT91_SMC_TDF_(1)),
+		AT91C_BASE_SMC0 + SMC_CTRL0);
+}
+#endif /* #ifdef CONFIG_FLASH */
@@ -44,9 +44,18 @@
 #endif /* #if defined(CONFIG_CRYSTAL_16_36766MHZ) */
 
 #if defined(CONFIG_CRYSTAL_18_432MHZ)
+#if defined(CONFIG_CLOCK_BOOST)
+/* Load the image at 240 MHz, hand over to the image at 200 MHz */
+#define MASTER_CLOCK		(240000000/2)
+#define PLLA_SETTINGS		0x2271BF30
+#define FINAL_MASTER_CLOCK	(198656000/2)
+#define FINAL_PLLA_SETTINGS	0x2060BF09
+#define BOARD_MAINOSC		18432000
+#else
 #define MASTER_CLOCK		(198656000/2)
-#define PLL_LOCK_TIMEOUT	1000000
 #define PLLA_SETTINGS		0x2060BF09
+#endif /* #if defined(CONFIG_CLOCK_BOOST) */
+#define PLL_LOCK_TIMEOUT	1000000
 #define PLLB_SETTINGS		0x10483F0E
 #endif /* #if defined(CONFIG_CRYSTAL_18_432MHZ) */
 #endif /* #if defined(CONFIG_CPU_CLK_200MHZ) */
@@ -103,11 +112,20 @@
 
 #define CONFIG_SYS_NAND_ENABLE_PIN	AT91C_PIN_PD(15)
 
+/*
+ * NorFlash Settings
+ */
+#define CONFIG_SYS_NOR_BASE		AT91C_BASE_EBI0_CS0
+#define CONFIG_SYS_NOR_SMC		AT91C_BASE_SMC0
+
 /*
  * MCI Settings
  */
 #define CONFIG_SYS_BASE_MCI		AT91C_BASE_MCI1
 
+/* SD/MMC fast init cache, Linux keeps the RTT based RTC in GPBR0 */
+#define CONFIG_SYS_MMC_CACHE_GPBR	1
+
 /*
  * Recovery Button
  */
@@ -117,9 +135,13 @@
 /* export function */
 extern void hw_init(void);
 
+extern void hw_clock_handoff(void);
+
 extern void nandflash_hw_init(void);
 extern void nandflash_config_buswidth(unsigned char busw);
 
+extern void norflash_hw_init(void);
+
 extern void at91_spi0_hw_init(void);
 
 extern void at91_mci0_hw_init(void);
@@ -300,6 +300,14 @@ void at91_mci0_hw_init(void)
 }
 #endif /* #ifdef CONFIG_SDCARD */
 
+#ifdef CONFIG_DMAC
+void at91_dmac_hw_init(void)
+{
+	/* Enable the clock */
+	writel((1 << CONFIG_SYS_ID_DMAC), (PMC_PCER + AT91C_BASE_PMC));
+}
+#endif /* #ifdef CONFIG_DMAC */
+
 #ifdef CONFIG_NANDFLASH
 void nandflash_hw_init(void)
 {
@@ -94,6 +94,18 @@
  */
 #define CONFIG_SYS_BASE_MCI     AT91C_BASE_MCI0
 
+/* SD/MMC fast init cache, Linux keeps the RTT based RTC in GPBR0 */
+#define CONFIG_SYS_MMC_CACHE_GPBR	1
+
+/*
+ * DMAC Settings
+ */
+#define CONFIG_SYS_BASE_DMAC	AT91C_BASE_DMAC
+#define CONFIG_SYS_ID_DMAC	AT91C_ID_DMAC
+
+/* Hardware handshaking interfaces */
+#define CONFIG_SYS_DMAC_PER_ID_MCI	0
+
 /*
  * Recovery
  */
@@ -111,4 +123,6 @@ extern void at91_spi0_hw_init(void);
 
 extern void at91_mci0_hw_init(void);
 
+extern void at91_dmac_hw_init(void);
+
 #endif /* __AT91SAM9M10G45EK_H__ */
@@ -89,6 +89,9 @@
  */
 #define CONFIG_SYS_BASE_MCI	AT91C_BASE_MCI
 
+/* SD/MMC fast init cache, Linux keeps the RTT based RTC in GPBR0 */
+#define CONFIG_SYS_MMC_CACHE_GPBR	1
+
 /*
  * Recovery
  */
@@ -39,11 +39,17 @@
 #include "dbgu.h"
 #include "debug.h"
 #include "ddramc.h"
+#include "dram_timing.h"
+#include "dram_parts.h"
 #include "slowclk.h"
 #include "at91sam9x5ek.h"
 
 #include "onewire_info.h"
 
+#if defined(CONFIG_BOOT_TASKS) && defined(CONFIG_SDCARD)
+#include "media.h"
+#endif
+
 #ifdef CONFIG_USER_HW_INIT
 extern void hw_init_hook(void);
 #endif
@@ -71,7 +77,9 @@ static void initialize_dbgu(void)
 
 #ifdef CONFIG_DDR2
 /* Using the Micron MT47H64M16HR-3 */
-static void ddramc_reg_config(struct ddramc_register *ddramc_config)
+static const struct dram_timing ddram_timing = DRAM_MT47H64M16HR_3;
+
+static int ddramc_reg_config(struct ddramc_register *ddramc_config)
 {
 	ddramc_config->mdr = (AT91C_DDRC2_DBW_16_BITS
 			| AT91C_DDRC2_MD_DDR2_SDRAM);
@@ -83,34 +91,7 @@ static void ddramc_reg_config(struct ddramc_register *ddramc_config)
 			| AT91C_DDRC2_DLL_RESET_DISABLED /* DLL not reset */
 			| AT91C_DDRC2_DECOD_INTERLEAVED);/*Interleaved decode*/
 
-	/*
-	 * The DDR2-SDRAM device requires a refresh every 15.625 us or 7.81 us.
-	 * With a 133 MHz frequency, the refresh timer count register must to be
-	 * set with (15.625 x 133 MHz) ~ 2084 i.e. 0x824
-	 * or (7.81 x 133 MHz) ~ 1040 i.e. 0x410.
-	 */
-	ddramc_config->rtr = 0x411;     /* Refresh timer: 7.8125us */
-
-	/* One clock cycle @ 133 MHz = 7.5 ns */
-	ddramc_config->t0pr = (AT91C_DDRC2_TRAS_6       /* 6 * 7.5 = 45 ns */
-			| AT91C_DDRC2_TRCD_2            /* 2 * 7.5 = 22.5 ns */
-			| AT91C_DDRC2_TWR_2             /* 2 * 7.5 = 15   ns */
-			| AT91C_DDRC2_TRC_8             /* 8 * 7.5 = 75   ns */
-			| AT91C_DDRC2_TRP_2             /* 2 * 7.5 = 15   ns */
-			| AT91C_DDRC2_TRRD_2            /* 2 * 7.5 = 15   ns */
-			| AT91C_DDRC2_TWTR_2            /* 2 clock cycles min */
-			| AT91C_DDRC2_TMRD_2);          /* 2 clock cycles */
-
-	ddramc_config->t1pr = (AT91C_DDRC2_TXP_2        /*  2 clock cycles */
-			| 200 << 16                     /* 200 clock cycles */
-			| 19 << 8                       /* 19 * 7.5 = 142.5 ns*/
-			| AT91C_DDRC2_TRFC_18);         /* 18 * 7.5 = 135 ns */
-
-	ddramc_config->t2pr = (AT91C_DDRC2_TFAW_7       /* 7 * 7.5 = 52.5 ns */
-			| AT91C_DDRC2_TRTP_2            /* 2 clock cycles min */
-			| AT91C_DDRC2_TRPA_3            /* 3 * 7.5 = 22.5 ns */
-			| AT91C_DDRC2_TXARDS_7          /* 7 clock cycles */
-			| AT91C_DDRC2_TXARD_2);         /* 2 clock cycles */
+	return ddramc_timing(ddramc_config, &ddram_timing, MASTER_CLOCK);
 }
 
 static void ddramc_init(void)
@@ -118,7 +99,9 @@ static void ddramc_init(void)
 	unsigned long csa;
 	struct ddramc_register ddramc_reg;
 
-	ddramc_reg_config(&ddramc_reg);
+	/* Hang: the DDR2 can not be run at this MCK, the error is logged */
+	if (ddramc_reg_config(&ddramc_reg))
+		while (1);
 
 	/* ENABLE DDR2 clock */
 	writel(AT91C_PMC_DDR, AT91C_BASE_PMC + PMC_SCER);
@@ -169,6 +152,15 @@ void hw_init(void)
 	initialize_dbgu();
 #endif
 
+#if defined(CONFIG_BOOT_TASKS) && defined(CONFIG_SDCARD)
+	/*
+	 * The SD card power ramp runs out during the DDR setup, its
+	 * commands are only stepped between the 1-wire bytes.
+	 */
+	at91_mci0_hw_init();
+	mmc_power_up_start();
+#endif
+
 #ifdef CONFIG_DDR2
 	/* Initialize DDRAM Controller */
 	ddramc_init();
@@ -223,6 +215,14 @@ void at91_mci0_hw_init(void)
 }
 #endif /* #ifdef CONFIG_SDCARD */
 
+#ifdef CONFIG_DMAC
+void at91_dmac_hw_init(void)
+{
+	/* Enable the clock */
+	writel((1 << CONFIG_SYS_ID_DMAC), (PMC_PCER + AT91C_BASE_PMC));
+}
+#endif /* #ifdef CONFIG_DMAC */
+
 #ifdef CONFIG_NANDFLASH
 void nandflash_hw_init(void)
 {
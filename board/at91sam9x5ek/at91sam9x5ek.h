@@ -102,6 +102,23 @@
  */
 #define CONFIG_SYS_BASE_MCI	AT91C_BASE_HSMCI0
 
+/* SD/MMC fast init cache, GPBR2/3 pass the 1-wire board information on */
+#define CONFIG_SYS_MMC_CACHE_GPBR	0
+
+/* 1-wire cache check word, shares GPBR1 with the SD/MMC cache */
+#define CONFIG_SYS_ONEWIRE_CACHE_GPBR	1
+
+/*
+ * DMAC Settings
+ */
+#define CONFIG_SYS_BASE_DMAC	AT91C_BASE_DMAC0
+#define CONFIG_SYS_ID_DMAC	AT91C_ID_DMAC0
+
+/* Hardware handshaking interfaces */
+#define CONFIG_SYS_DMAC_PER_ID_MCI	0
+#define CONFIG_SYS_DMAC_PER_ID_SPI_TX	1
+#define CONFIG_SYS_DMAC_PER_ID_SPI_RX	2
+
 /* function */
 extern void hw_init(void);
 
@@ -112,4 +129,6 @@ extern void at91_spi0_hw_init(void);
 
 extern void at91_mci0_hw_init(void);
 
+extern void at91_dmac_hw_init(void);
+
 #endif /*#ifndef __AT91SAM9X5EK_H__ */
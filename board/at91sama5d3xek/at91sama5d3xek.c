@@ -221,6 +221,12 @@ void at91_mci0_hw_init(void)
 		{"MCDA1", AT91C_PIN_PD(2), 0, PIO_PULLUP, PIO_PERIPH_A},
 		{"MCDA2", AT91C_PIN_PD(3), 0, PIO_PULLUP, PIO_PERIPH_A},
 		{"MCDA3", AT91C_PIN_PD(4), 0, PIO_PULLUP, PIO_PERIPH_A},
+#ifdef CONFIG_SDCARD_8BIT
+		{"MCDA4", AT91C_PIN_PD(5), 0, PIO_PULLUP, PIO_PERIPH_A},
+		{"MCDA5", AT91C_PIN_PD(6), 0, PIO_PULLUP, PIO_PERIPH_A},
+		{"MCDA6", AT91C_PIN_PD(7), 0, PIO_PULLUP, PIO_PERIPH_A},
+		{"MCDA7", AT91C_PIN_PD(8), 0, PIO_PULLUP, PIO_PERIPH_A},
+#endif
 		{(char *)0, 0, 0, PIO_DEFAULT, PIO_PERIPH_A},
 	};
 
@@ -233,6 +239,14 @@ void at91_mci0_hw_init(void)
 }
 #endif /* #ifdef CONFIG_SDCARD */
 
+#ifdef CONFIG_DMAC
+void at91_dmac_hw_init(void)
+{
+	/* Enable the clock */
+	writel((1 << CONFIG_SYS_ID_DMAC), (PMC_PCER + AT91C_BASE_PMC));
+}
+#endif /* #ifdef CONFIG_DMAC */
+
 #ifdef CONFIG_NANDFLASH
 void nandflash_hw_init(void)
 {
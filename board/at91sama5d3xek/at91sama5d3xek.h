@@ -119,6 +119,23 @@
  */
 #define CONFIG_SYS_BASE_MCI	AT91C_BASE_HSMCI0	
 
+/* SD/MMC fast init cache, the RTC of this chip does not use the GPBR */
+#define CONFIG_SYS_MMC_CACHE_GPBR	0
+
+/*
+ * DMAC Settings
+ */
+#define CONFIG_SYS_BASE_DMAC	AT91C_BASE_DMAC0
+#define CONFIG_SYS_ID_DMAC	AT91C_ID_DMAC0
+
+/* The peripherals are on the AHB interface 2 of the DMAC0 */
+#define CONFIG_SYS_DMAC_PER_IF	2
+
+/* Hardware handshaking interfaces */
+#define CONFIG_SYS_DMAC_PER_ID_MCI	0
+#define CONFIG_SYS_DMAC_PER_ID_SPI_TX	1
+#define CONFIG_SYS_DMAC_PER_ID_SPI_RX	2
+
 /*
  * Recovery function
  */
@@ -135,4 +152,6 @@ extern void at91_spi0_hw_init(void);
 
 extern void at91_mci0_hw_init(void);
 
+extern void at91_dmac_hw_init(void);
+
 #endif /* #ifndef __AT91SAMA5EK_H__ */
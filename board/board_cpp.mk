@@ -71,6 +71,10 @@ ifeq ($(CONFIG_CPU_CLK_533MHZ),y)
 CPPFLAGS += -DCONFIG_CPU_CLK_533MHZ
 endif
 
+ifeq ($(CONFIG_CLOCK_BOOST),y)
+CPPFLAGS += -DCONFIG_CLOCK_BOOST
+endif
+
 # Bus speed
 
 ifeq ($(CONFIG_BUS_SPEED_83MHZ),y)
@@ -0,0 +1,452 @@
+mkdir /fill
+write /root/repo/build/host/src/boot/block /fill/1
+write /root/repo/build/host/src/boot/block /fill/2
+write /root/repo/build/host/src/boot/block /fill/3
+write /root/repo/build/host/src/boot/block /fill/4
+write /root/repo/build/host/src/boot/block /fill/5
+write /root/repo/build/host/src/boot/block /fill/6
+write /root/repo/build/host/src/boot/block /fill/7
+write /root/repo/build/host/src/boot/block /fill/8
+write /root/repo/build/host/src/boot/block /fill/9
+write /root/repo/build/host/src/boot/block /fill/10
+write /root/repo/build/host/src/boot/block /fill/11
+write /root/repo/build/host/src/boot/block /fill/12
+write /root/repo/build/host/src/boot/block /fill/13
+write /root/repo/build/host/src/boot/block /fill/14
+write /root/repo/build/host/src/boot/block /fill/15
+write /root/repo/build/host/src/boot/block /fill/16
+write /root/repo/build/host/src/boot/block /fill/17
+write /root/repo/build/host/src/boot/block /fill/18
+write /root/repo/build/host/src/boot/block /fill/19
+write /root/repo/build/host/src/boot/block /fill/20
+write /root/repo/build/host/src/boot/block /fill/21
+write /root/repo/build/host/src/boot/block /fill/22
+write /root/repo/build/host/src/boot/block /fill/23
+write /root/repo/build/host/src/boot/block /fill/24
+write /root/repo/build/host/src/boot/block /fill/25
+write /root/repo/build/host/src/boot/block /fill/26
+write /root/repo/build/host/src/boot/block /fill/27
+write /root/repo/build/host/src/boot/block /fill/28
+write /root/repo/build/host/src/boot/block /fill/29
+write /root/repo/build/host/src/boot/block /fill/30
+write /root/repo/build/host/src/boot/block /fill/31
+write /root/repo/build/host/src/boot/block /fill/32
+write /root/repo/build/host/src/boot/block /fill/33
+write /root/repo/build/host/src/boot/block /fill/34
+write /root/repo/build/host/src/boot/block /fill/35
+write /root/repo/build/host/src/boot/block /fill/36
+write /root/repo/build/host/src/boot/block /fill/37
+write /root/repo/build/host/src/boot/block /fill/38
+write /root/repo/build/host/src/boot/block /fill/39
+write /root/repo/build/host/src/boot/block /fill/40
+write /root/repo/build/host/src/boot/block /fill/41
+write /root/repo/build/host/src/boot/block /fill/42
+write /root/repo/build/host/src/boot/block /fill/43
+write /root/repo/build/host/src/boot/block /fill/44
+write /root/repo/build/host/src/boot/block /fill/45
+write /root/repo/build/host/src/boot/block /fill/46
+write /root/repo/build/host/src/boot/block /fill/47
+write /root/repo/build/host/src/boot/block /fill/48
+write /root/repo/build/host/src/boot/block /fill/49
+write /root/repo/build/host/src/boot/block /fill/50
+write /root/repo/build/host/src/boot/block /fill/51
+write /root/repo/build/host/src/boot/block /fill/52
+write /root/repo/build/host/src/boot/block /fill/53
+write /root/repo/build/host/src/boot/block /fill/54
+write /root/repo/build/host/src/boot/block /fill/55
+write /root/repo/build/host/src/boot/block /fill/56
+write /root/repo/build/host/src/boot/block /fill/57
+write /root/repo/build/host/src/boot/block /fill/58
+write /root/repo/build/host/src/boot/block /fill/59
+write /root/repo/build/host/src/boot/block /fill/60
+write /root/repo/build/host/src/boot/block /fill/61
+write /root/repo/build/host/src/boot/block /fill/62
+write /root/repo/build/host/src/boot/block /fill/63
+write /root/repo/build/host/src/boot/block /fill/64
+write /root/repo/build/host/src/boot/block /fill/65
+write /root/repo/build/host/src/boot/block /fill/66
+write /root/repo/build/host/src/boot/block /fill/67
+write /root/repo/build/host/src/boot/block /fill/68
+write /root/repo/build/host/src/boot/block /fill/69
+write /root/repo/build/host/src/boot/block /fill/70
+write /root/repo/build/host/src/boot/block /fill/71
+write /root/repo/build/host/src/boot/block /fill/72
+write /root/repo/build/host/src/boot/block /fill/73
+write /root/repo/build/host/src/boot/block /fill/74
+write /root/repo/build/host/src/boot/block /fill/75
+write /root/repo/build/host/src/boot/block /fill/76
+write /root/repo/build/host/src/boot/block /fill/77
+write /root/repo/build/host/src/boot/block /fill/78
+write /root/repo/build/host/src/boot/block /fill/79
+write /root/repo/build/host/src/boot/block /fill/80
+write /root/repo/build/host/src/boot/block /fill/81
+write /root/repo/build/host/src/boot/block /fill/82
+write /root/repo/build/host/src/boot/block /fill/83
+write /root/repo/build/host/src/boot/block /fill/84
+write /root/repo/build/host/src/boot/block /fill/85
+write /root/repo/build/host/src/boot/block /fill/86
+write /root/repo/build/host/src/boot/block /fill/87
+write /root/repo/build/host/src/boot/block /fill/88
+write /root/repo/build/host/src/boot/block /fill/89
+write /root/repo/build/host/src/boot/block /fill/90
+write /root/repo/build/host/src/boot/block /fill/91
+write /root/repo/build/host/src/boot/block /fill/92
+write /root/repo/build/host/src/boot/block /fill/93
+write /root/repo/build/host/src/boot/block /fill/94
+write /root/repo/build/host/src/boot/block /fill/95
+write /root/repo/build/host/src/boot/block /fill/96
+write /root/repo/build/host/src/boot/block /fill/97
+write /root/repo/build/host/src/boot/block /fill/98
+write /root/repo/build/host/src/boot/block /fill/99
+write /root/repo/build/host/src/boot/block /fill/100
+write /root/repo/build/host/src/boot/block /fill/101
+write /root/repo/build/host/src/boot/block /fill/102
+write /root/repo/build/host/src/boot/block /fill/103
+write /root/repo/build/host/src/boot/block /fill/104
+write /root/repo/build/host/src/boot/block /fill/105
+write /root/repo/build/host/src/boot/block /fill/106
+write /root/repo/build/host/src/boot/block /fill/107
+write /root/repo/build/host/src/boot/block /fill/108
+write /root/repo/build/host/src/boot/block /fill/109
+write /root/repo/build/host/src/boot/block /fill/110
+write /root/repo/build/host/src/boot/block /fill/111
+write /root/repo/build/host/src/boot/block /fill/112
+write /root/repo/build/host/src/boot/block /fill/113
+write /root/repo/build/host/src/boot/block /fill/114
+write /root/repo/build/host/src/boot/block /fill/115
+write /root/repo/build/host/src/boot/block /fill/116
+write /root/repo/build/host/src/boot/block /fill/117
+write /root/repo/build/host/src/boot/block /fill/118
+write /root/repo/build/host/src/boot/block /fill/119
+write /root/repo/build/host/src/boot/block /fill/120
+write /root/repo/build/host/src/boot/block /fill/121
+write /root/repo/build/host/src/boot/block /fill/122
+write /root/repo/build/host/src/boot/block /fill/123
+write /root/repo/build/host/src/boot/block /fill/124
+write /root/repo/build/host/src/boot/block /fill/125
+write /root/repo/build/host/src/boot/block /fill/126
+write /root/repo/build/host/src/boot/block /fill/127
+write /root/repo/build/host/src/boot/block /fill/128
+write /root/repo/build/host/src/boot/block /fill/129
+write /root/repo/build/host/src/boot/block /fill/130
+write /root/repo/build/host/src/boot/block /fill/131
+write /root/repo/build/host/src/boot/block /fill/132
+write /root/repo/build/host/src/boot/block /fill/133
+write /root/repo/build/host/src/boot/block /fill/134
+write /root/repo/build/host/src/boot/block /fill/135
+write /root/repo/build/host/src/boot/block /fill/136
+write /root/repo/build/host/src/boot/block /fill/137
+write /root/repo/build/host/src/boot/block /fill/138
+write /root/repo/build/host/src/boot/block /fill/139
+write /root/repo/build/host/src/boot/block /fill/140
+write /root/repo/build/host/src/boot/block /fill/141
+write /root/repo/build/host/src/boot/block /fill/142
+write /root/repo/build/host/src/boot/block /fill/143
+write /root/repo/build/host/src/boot/block /fill/144
+write /root/repo/build/host/src/boot/block /fill/145
+write /root/repo/build/host/src/boot/block /fill/146
+write /root/repo/build/host/src/boot/block /fill/147
+write /root/repo/build/host/src/boot/block /fill/148
+write /root/repo/build/host/src/boot/block /fill/149
+write /root/repo/build/host/src/boot/block /fill/150
+write /root/repo/build/host/src/boot/block /fill/151
+write /root/repo/build/host/src/boot/block /fill/152
+write /root/repo/build/host/src/boot/block /fill/153
+write /root/repo/build/host/src/boot/block /fill/154
+write /root/repo/build/host/src/boot/block /fill/155
+write /root/repo/build/host/src/boot/block /fill/156
+write /root/repo/build/host/src/boot/block /fill/157
+write /root/repo/build/host/src/boot/block /fill/158
+write /root/repo/build/host/src/boot/block /fill/159
+write /root/repo/build/host/src/boot/block /fill/160
+write /root/repo/build/host/src/boot/block /fill/161
+write /root/repo/build/host/src/boot/block /fill/162
+write /root/repo/build/host/src/boot/block /fill/163
+write /root/repo/build/host/src/boot/block /fill/164
+write /root/repo/build/host/src/boot/block /fill/165
+write /root/repo/build/host/src/boot/block /fill/166
+write /root/repo/build/host/src/boot/block /fill/167
+write /root/repo/build/host/src/boot/block /fill/168
+write /root/repo/build/host/src/boot/block /fill/169
+write /root/repo/build/host/src/boot/block /fill/170
+write /root/repo/build/host/src/boot/block /fill/171
+write /root/repo/build/host/src/boot/block /fill/172
+write /root/repo/build/host/src/boot/block /fill/173
+write /root/repo/build/host/src/boot/block /fill/174
+write /root/repo/build/host/src/boot/block /fill/175
+write /root/repo/build/host/src/boot/block /fill/176
+write /root/repo/build/host/src/boot/block /fill/177
+write /root/repo/build/host/src/boot/block /fill/178
+write /root/repo/build/host/src/boot/block /fill/179
+write /root/repo/build/host/src/boot/block /fill/180
+write /root/repo/build/host/src/boot/block /fill/181
+write /root/repo/build/host/src/boot/block /fill/182
+write /root/repo/build/host/src/boot/block /fill/183
+write /root/repo/build/host/src/boot/block /fill/184
+write /root/repo/build/host/src/boot/block /fill/185
+write /root/repo/build/host/src/boot/block /fill/186
+write /root/repo/build/host/src/boot/block /fill/187
+write /root/repo/build/host/src/boot/block /fill/188
+write /root/repo/build/host/src/boot/block /fill/189
+write /root/repo/build/host/src/boot/block /fill/190
+write /root/repo/build/host/src/boot/block /fill/191
+write /root/repo/build/host/src/boot/block /fill/192
+write /root/repo/build/host/src/boot/block /fill/193
+write /root/repo/build/host/src/boot/block /fill/194
+write /root/repo/build/host/src/boot/block /fill/195
+write /root/repo/build/host/src/boot/block /fill/196
+write /root/repo/build/host/src/boot/block /fill/197
+write /root/repo/build/host/src/boot/block /fill/198
+write /root/repo/build/host/src/boot/block /fill/199
+write /root/repo/build/host/src/boot/block /fill/200
+write /root/repo/build/host/src/boot/block /fill/201
+write /root/repo/build/host/src/boot/block /fill/202
+write /root/repo/build/host/src/boot/block /fill/203
+write /root/repo/build/host/src/boot/block /fill/204
+write /root/repo/build/host/src/boot/block /fill/205
+write /root/repo/build/host/src/boot/block /fill/206
+write /root/repo/build/host/src/boot/block /fill/207
+write /root/repo/build/host/src/boot/block /fill/208
+write /root/repo/build/host/src/boot/block /fill/209
+write /root/repo/build/host/src/boot/block /fill/210
+write /root/repo/build/host/src/boot/block /fill/211
+write /root/repo/build/host/src/boot/block /fill/212
+write /root/repo/build/host/src/boot/block /fill/213
+write /root/repo/build/host/src/boot/block /fill/214
+write /root/repo/build/host/src/boot/block /fill/215
+write /root/repo/build/host/src/boot/block /fill/216
+write /root/repo/build/host/src/boot/block /fill/217
+write /root/repo/build/host/src/boot/block /fill/218
+write /root/repo/build/host/src/boot/block /fill/219
+write /root/repo/build/host/src/boot/block /fill/220
+write /root/repo/build/host/src/boot/block /fill/221
+write /root/repo/build/host/src/boot/block /fill/222
+write /root/repo/build/host/src/boot/block /fill/223
+write /root/repo/build/host/src/boot/block /fill/224
+write /root/repo/build/host/src/boot/block /fill/225
+write /root/repo/build/host/src/boot/block /fill/226
+write /root/repo/build/host/src/boot/block /fill/227
+write /root/repo/build/host/src/boot/block /fill/228
+write /root/repo/build/host/src/boot/block /fill/229
+write /root/repo/build/host/src/boot/block /fill/230
+write /root/repo/build/host/src/boot/block /fill/231
+write /root/repo/build/host/src/boot/block /fill/232
+write /root/repo/build/host/src/boot/block /fill/233
+write /root/repo/build/host/src/boot/block /fill/234
+write /root/repo/build/host/src/boot/block /fill/235
+write /root/repo/build/host/src/boot/block /fill/236
+write /root/repo/build/host/src/boot/block /fill/237
+write /root/repo/build/host/src/boot/block /fill/238
+write /root/repo/build/host/src/boot/block /fill/239
+write /root/repo/build/host/src/boot/block /fill/240
+write /root/repo/build/host/src/boot/block /fill/241
+write /root/repo/build/host/src/boot/block /fill/242
+write /root/repo/build/host/src/boot/block /fill/243
+write /root/repo/build/host/src/boot/block /fill/244
+write /root/repo/build/host/src/boot/block /fill/245
+write /root/repo/build/host/src/boot/block /fill/246
+write /root/repo/build/host/src/boot/block /fill/247
+write /root/repo/build/host/src/boot/block /fill/248
+write /root/repo/build/host/src/boot/block /fill/249
+write /root/repo/build/host/src/boot/block /fill/250
+write /root/repo/build/host/src/boot/block /fill/251
+write /root/repo/build/host/src/boot/block /fill/252
+write /root/repo/build/host/src/boot/block /fill/253
+write /root/repo/build/host/src/boot/block /fill/254
+write /root/repo/build/host/src/boot/block /fill/255
+write /root/repo/build/host/src/boot/block /fill/256
+write /root/repo/build/host/src/boot/block /fill/257
+write /root/repo/build/host/src/boot/block /fill/258
+write /root/repo/build/host/src/boot/block /fill/259
+write /root/repo/build/host/src/boot/block /fill/260
+write /root/repo/build/host/src/boot/block /fill/261
+write /root/repo/build/host/src/boot/block /fill/262
+write /root/repo/build/host/src/boot/block /fill/263
+write /root/repo/build/host/src/boot/block /fill/264
+write /root/repo/build/host/src/boot/block /fill/265
+write /root/repo/build/host/src/boot/block /fill/266
+write /root/repo/build/host/src/boot/block /fill/267
+write /root/repo/build/host/src/boot/block /fill/268
+write /root/repo/build/host/src/boot/block /fill/269
+write /root/repo/build/host/src/boot/block /fill/270
+write /root/repo/build/host/src/boot/block /fill/271
+write /root/repo/build/host/src/boot/block /fill/272
+write /root/repo/build/host/src/boot/block /fill/273
+write /root/repo/build/host/src/boot/block /fill/274
+write /root/repo/build/host/src/boot/block /fill/275
+write /root/repo/build/host/src/boot/block /fill/276
+write /root/repo/build/host/src/boot/block /fill/277
+write /root/repo/build/host/src/boot/block /fill/278
+write /root/repo/build/host/src/boot/block /fill/279
+write /root/repo/build/host/src/boot/block /fill/280
+write /root/repo/build/host/src/boot/block /fill/281
+write /root/repo/build/host/src/boot/block /fill/282
+write /root/repo/build/host/src/boot/block /fill/283
+write /root/repo/build/host/src/boot/block /fill/284
+write /root/repo/build/host/src/boot/block /fill/285
+write /root/repo/build/host/src/boot/block /fill/286
+write /root/repo/build/host/src/boot/block /fill/287
+write /root/repo/build/host/src/boot/block /fill/288
+write /root/repo/build/host/src/boot/block /fill/289
+write /root/repo/build/host/src/boot/block /fill/290
+write /root/repo/build/host/src/boot/block /fill/291
+write /root/repo/build/host/src/boot/block /fill/292
+write /root/repo/build/host/src/boot/block /fill/293
+write /root/repo/build/host/src/boot/block /fill/294
+write /root/repo/build/host/src/boot/block /fill/295
+write /root/repo/build/host/src/boot/block /fill/296
+write /root/repo/build/host/src/boot/block /fill/297
+write /root/repo/build/host/src/boot/block /fill/298
+write /root/repo/build/host/src/boot/block /fill/299
+write /root/repo/build/host/src/boot/block /fill/300
+rm /fill/1
+rm /fill/3
+rm /fill/5
+rm /fill/7
+rm /fill/9
+rm /fill/11
+rm /fill/13
+rm /fill/15
+rm /fill/17
+rm /fill/19
+rm /fill/21
+rm /fill/23
+rm /fill/25
+rm /fill/27
+rm /fill/29
+rm /fill/31
+rm /fill/33
+rm /fill/35
+rm /fill/37
+rm /fill/39
+rm /fill/41
+rm /fill/43
+rm /fill/45
+rm /fill/47
+rm /fill/49
+rm /fill/51
+rm /fill/53
+rm /fill/55
+rm /fill/57
+rm /fill/59
+rm /fill/61
+rm /fill/63
+rm /fill/65
+rm /fill/67
+rm /fill/69
+rm /fill/71
+rm /fill/73
+rm /fill/75
+rm /fill/77
+rm /fill/79
+rm /fill/81
+rm /fill/83
+rm /fill/85
+rm /fill/87
+rm /fill/89
+rm /fill/91
+rm /fill/93
+rm /fill/95
+rm /fill/97
+rm /fill/99
+rm /fill/101
+rm /fill/103
+rm /fill/105
+rm /fill/107
+rm /fill/109
+rm /fill/111
+rm /fill/113
+rm /fill/115
+rm /fill/117
+rm /fill/119
+rm /fill/121
+rm /fill/123
+rm /fill/125
+rm /fill/127
+rm /fill/129
+rm /fill/131
+rm /fill/133
+rm /fill/135
+rm /fill/137
+rm /fill/139
+rm /fill/141
+rm /fill/143
+rm /fill/145
+rm /fill/147
+rm /fill/149
+rm /fill/151
+rm /fill/153
+rm /fill/155
+rm /fill/157
+rm /fill/159
+rm /fill/161
+rm /fill/163
+rm /fill/165
+rm /fill/167
+rm /fill/169
+rm /fill/171
+rm /fill/173
+rm /fill/175
+rm /fill/177
+rm /fill/179
+rm /fill/181
+rm /fill/183
+rm /fill/185
+rm /fill/187
+rm /fill/189
+rm /fill/191
+rm /fill/193
+rm /fill/195
+rm /fill/197
+rm /fill/199
+rm /fill/201
+rm /fill/203
+rm /fill/205
+rm /fill/207
+rm /fill/209
+rm /fill/211
+rm /fill/213
+rm /fill/215
+rm /fill/217
+rm /fill/219
+rm /fill/221
+rm /fill/223
+rm /fill/225
+rm /fill/227
+rm /fill/229
+rm /fill/231
+rm /fill/233
+rm /fill/235
+rm /fill/237
+rm /fill/239
+rm /fill/241
+rm /fill/243
+rm /fill/245
+rm /fill/247
+rm /fill/249
+rm /fill/251
+rm /fill/253
+rm /fill/255
+rm /fill/257
+rm /fill/259
+rm /fill/261
+rm /fill/263
+rm /fill/265
+rm /fill/267
+rm /fill/269
+rm /fill/271
+rm /fill/273
+rm /fill/275
+rm /fill/277
+rm /fill/279
+rm /fill/281
+rm /fill/283
+rm /fill/285
+rm /fill/287
+rm /fill/289
+rm /fill/291
+rm /fill/293
+rm /fill/295
+rm /fill/297
+rm /fill/299
+write /root/repo/build/host/frag /boot/frag
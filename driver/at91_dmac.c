@@ -0,0 +1,283 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "common.h"
+#include "hardware.h"
+#include "arch/at91_dmac.h"
+#include "dmac.h"
+#include "debug.h"
+#include "board.h"
+
+/*
+ * AHB interfaces used to reach memory and the peripherals,
+ * the board may override them.
+ */
+#ifndef CONFIG_SYS_DMAC_MEM_IF
+#define CONFIG_SYS_DMAC_MEM_IF	0
+#endif
+
+#ifndef CONFIG_SYS_DMAC_PER_IF
+#define CONFIG_SYS_DMAC_PER_IF	1
+#endif
+
+#define dmac_readl(reg)		\
+	readl(CONFIG_SYS_BASE_DMAC + reg)
+
+#define dmac_writel(reg, value)	\
+	writel(value, CONFIG_SYS_BASE_DMAC + reg)
+
+static struct dmac_desc dmac_desc_pool[DMAC_NR_CHANNELS][DMAC_DESC_PER_CHANNEL];
+
+/* EBCISR is cleared on read, keep the flags of every channel here */
+static unsigned int dmac_status;
+
+static int dmac_ready;
+
+static unsigned int dmac_update_status(void)
+{
+	dmac_status |= dmac_readl(DMAC_EBCISR);
+
+	return dmac_status;
+}
+
+/*
+ * Resets the whole controller, only once: the MCI, SPI and NOR drivers
+ * share it and each of them owns a channel.
+ */
+int dmac_init(void)
+{
+	if (dmac_ready)
+		return 0;
+
+	at91_dmac_hw_init();
+
+	dmac_writel(DMAC_EN, 0);
+	dmac_writel(DMAC_CHDR, 0xff);
+	dmac_writel(DMAC_EBCIDR, 0xffffffff);
+	(void)dmac_readl(DMAC_EBCISR);
+	dmac_status = 0;
+
+	dmac_writel(DMAC_GCFG, AT91C_DMAC_ARB_CFG_ROUND_ROBIN);
+	dmac_writel(DMAC_EN, AT91C_DMAC_ENABLE);
+
+	dmac_ready = 1;
+
+	return 0;
+}
+
+/* Claims a channel for a driver, leaving the other channels alone */
+int dmac_request(unsigned int ch)
+{
+	if (ch >= DMAC_NR_CHANNELS)
+		return -1;
+
+	dmac_init();
+
+	dmac_stop(ch);
+	dmac_update_status();
+	dmac_status &= ~(AT91C_DMAC_BTC(ch)
+			| AT91C_DMAC_CBTC(ch)
+			| AT91C_DMAC_ERR(ch));
+
+	return 0;
+}
+
+int dmac_start(unsigned int ch, const struct dmac_xfer *xfer)
+{
+	struct dmac_desc *desc;
+	unsigned int chunk_bytes;
+	unsigned int ctrla, ctrlb, cfg;
+	unsigned int src = xfer->src;
+	unsigned int dst = xfer->dst;
+	unsigned int len = xfer->len;
+	unsigned int width = xfer->width;
+	unsigned int size;
+	unsigned int i;
+
+	if (ch >= DMAC_NR_CHANNELS)
+		return -1;
+
+	if ((len == 0) || (len & ((1 << width) - 1)))
+		return -1;
+
+	chunk_bytes = DMAC_MAX_BTSIZE << width;
+	if (len > DMAC_MAX_XFER_LEN(width)) {
+		dbg_log(1, "DMAC: transfer too long: %d bytes\n\r", len);
+		return -1;
+	}
+
+	if (dmac_readl(DMAC_CHSR) & AT91C_DMAC_ENA(ch))
+		return -1;
+
+	ctrla = AT91C_DMAC_SRC_WIDTH(width) | AT91C_DMAC_DST_WIDTH(width);
+	cfg = AT91C_DMAC_AHB_PROT(1) | AT91C_DMAC_FIFOCFG_HALF;
+
+	switch (xfer->type) {
+	case DMAC_MEM_TO_MEM:
+		ctrla |= AT91C_DMAC_SCSIZE_4 | AT91C_DMAC_DCSIZE_4;
+		ctrlb = AT91C_DMAC_FC_MEM2MEM
+			| AT91C_DMAC_SIF(CONFIG_SYS_DMAC_MEM_IF)
+			| AT91C_DMAC_DIF(CONFIG_SYS_DMAC_MEM_IF)
+			| AT91C_DMAC_SRC_INCR
+			| AT91C_DMAC_DST_INCR;
+		break;
+
+	case DMAC_MEM_TO_PER:
+		ctrla |= AT91C_DMAC_SCSIZE_1 | AT91C_DMAC_DCSIZE_1;
+		ctrlb = AT91C_DMAC_FC_MEM2PER
+			| AT91C_DMAC_SIF(CONFIG_SYS_DMAC_MEM_IF)
+			| AT91C_DMAC_DIF(CONFIG_SYS_DMAC_PER_IF)
+			| AT91C_DMAC_SRC_INCR
+			| AT91C_DMAC_DST_FIXED;
+		cfg |= AT91C_DMAC_DST_PER(xfer->per_id) | AT91C_DMAC_DST_H2SEL;
+		break;
+
+	case DMAC_PER_TO_MEM:
+		ctrla |= AT91C_DMAC_SCSIZE_1 | AT91C_DMAC_DCSIZE_1;
+		ctrlb = AT91C_DMAC_FC_PER2MEM
+			| AT91C_DMAC_SIF(CONFIG_SYS_DMAC_PER_IF)
+			| AT91C_DMAC_DIF(CONFIG_SYS_DMAC_MEM_IF)
+			| AT91C_DMAC_SRC_FIXED
+			| AT91C_DMAC_DST_INCR;
+		cfg |= AT91C_DMAC_SRC_PER(xfer->per_id) | AT91C_DMAC_SRC_H2SEL;
+		break;
+
+	default:
+		return -1;
+	}
+
+	/* Build the linked list, one descriptor per BTSIZE worth of data */
+	desc = dmac_desc_pool[ch];
+	for (i = 0; len; i++) {
+		size = (len > chunk_bytes) ? chunk_bytes : len;
+
+		desc[i].saddr = src;
+		desc[i].daddr = dst;
+		desc[i].ctrla = ctrla | (size >> width);
+		desc[i].ctrlb = ctrlb;
+		desc[i].dscr = (unsigned int)&desc[i + 1];
+
+		if (xfer->type != DMAC_PER_TO_MEM)
+			src += size;
+		if (xfer->type != DMAC_MEM_TO_PER)
+			dst += size;
+		len -= size;
+	}
+
+	/* Last descriptor ends the chain */
+	desc[i - 1].ctrlb |= AT91C_DMAC_SRC_DSCR | AT91C_DMAC_DST_DSCR;
+	desc[i - 1].dscr = 0;
+
+	dmac_update_status();
+	dmac_status &= ~(AT91C_DMAC_BTC(ch)
+			| AT91C_DMAC_CBTC(ch)
+			| AT91C_DMAC_ERR(ch));
+
+	dmac_writel(DMAC_SADDR(ch), 0);
+	dmac_writel(DMAC_DADDR(ch), 0);
+	dmac_writel(DMAC_CTRLA(ch), 0);
+	dmac_writel(DMAC_CTRLB(ch), ctrlb);
+	dmac_writel(DMAC_CFG(ch), cfg);
+	dmac_writel(DMAC_DSCR(ch), (unsigned int)desc);
+
+	dmac_writel(DMAC_CHER, AT91C_DMAC_ENA(ch));
+
+	return 0;
+}
+
+/*
+ * Returns 1 when the channel has finished, 0 while it is running
+ * and -1 if the controller reported an AHB error.
+ */
+int dmac_is_done(unsigned int ch)
+{
+	if (dmac_update_status() & AT91C_DMAC_ERR(ch)) {
+		dmac_stop(ch);
+		return -1;
+	}
+
+	if (dmac_readl(DMAC_CHSR) & AT91C_DMAC_ENA(ch))
+		return 0;
+
+	return 1;
+}
+
+int dmac_wait(unsigned int ch)
+{
+	int ret;
+
+	do {
+		ret = dmac_is_done(ch);
+	} while (ret == 0);
+
+	if (ret < 0) {
+		dbg_log(1, "DMAC: channel %d error\n\r", ch);
+		return -1;
+	}
+
+	return 0;
+}
+
+void dmac_stop(unsigned int ch)
+{
+	dmac_writel(DMAC_CHDR, AT91C_DMAC_DIS(ch));
+	while (dmac_readl(DMAC_CHSR) & AT91C_DMAC_ENA(ch))
+		;
+}
+
+int dmac_memcpy(void *dst, const void *src, unsigned int len)
+{
+	struct dmac_xfer xfer;
+	unsigned int max;
+
+	xfer.src = (unsigned int)src;
+	xfer.dst = (unsigned int)dst;
+	xfer.type = DMAC_MEM_TO_MEM;
+	xfer.per_id = 0;
+
+	if ((xfer.src | xfer.dst | len) & 0x03)
+		xfer.width = DMAC_WIDTH_BYTE;
+	else
+		xfer.width = DMAC_WIDTH_WORD;
+
+	max = DMAC_MAX_XFER_LEN(xfer.width);
+
+	while (len) {
+		xfer.len = (len > max) ? max : len;
+
+		if (dmac_start(DMAC_CH_MEMCPY, &xfer))
+			return -1;
+		if (dmac_wait(DMAC_CH_MEMCPY))
+			return -1;
+
+		xfer.src += xfer.len;
+		xfer.dst += xfer.len;
+		len -= xfer.len;
+	}
+
+	return 0;
+}
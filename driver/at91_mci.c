@@ -31,6 +31,21 @@
 #include "board.h"
 #include "arch/at91_mci.h"
 #include "mmc.h"
+#include "pit_timer.h"
+#ifdef CONFIG_BOOT_TASKS
+#include "task.h"
+#endif
+
+#ifdef CONFIG_SDCARD_DMA
+#if defined(AT91SAM9X5) || defined(AT91SAM9N12) || defined(AT91SAMA5D3X) \
+	|| defined(AT91SAM9G45)
+#define MCI_USE_DMAC
+#include "dmac.h"
+#else
+#define MCI_USE_PDC
+#include "arch/at91_pdc.h"
+#endif
+#endif
 
 #include "debug.h"
 
@@ -50,6 +65,7 @@
 #define MMC_CMD_SET_BLOCKLEN		16
 #define MMC_CMD_READ_SINGLE_BLOCK	17
 #define MMC_CMD_READ_MULTIPLE_BLOCK	18
+#define MMC_CMD_SET_BLOCK_COUNT		23
 #define MMC_CMD_WRITE_SINGLE_BLOCK	24
 #define MMC_CMD_WRITE_MULTIPLE_BLOCK	25
 #define MMC_CMD_APP_CMD			55
@@ -70,6 +86,13 @@
 
 #define MCI_SUPPORT_MAX_BLKS 65535
 
+/* Largest transfer handed to the DMA in one go */
+#if defined(MCI_USE_DMAC)
+#define MCI_DMA_MAX_LEN		DMAC_MAX_XFER_LEN(DMAC_WIDTH_WORD)
+#elif defined(MCI_USE_PDC)
+#define MCI_DMA_MAX_LEN		(2 * AT91C_PDC_MAX_COUNT * 4)
+#endif
+
 /* function macro */
 #define mci_readl(reg)					\
 	readl((void *)CONFIG_SYS_BASE_MCI + reg)
@@ -135,7 +158,7 @@ static int mci_set_bus_width(unsigned int buswidth)
 {
 	unsigned int reg;
 
-	reg = mci_readl(MCI_SDCR);
+	reg = mci_readl(MCI_SDCR) & ~AT91C_MCI_SCDBUS;
 
 	if (buswidth == 8)
 		reg |=  AT91C_MCI_SCDBUS_8BIT;
@@ -174,6 +197,10 @@ static void mci_init(void)
 
 	/* enable mci */
 	mci_writel(MCI_CR, AT91C_MCI_MCIEN);
+
+#ifdef MCI_USE_DMAC
+	dmac_request(DMAC_CH_MCI);
+#endif
 }
 
 /* response type definition */
@@ -306,7 +333,8 @@ static int mmc_send_if_cond(struct mmc *mmc)
 	return 0;
 }
 
-static int sd_send_op_cond(struct mmc *mmc)
+/* One round of CMD55 + ACMD41, the OCR is returned in ocr */
+static int sd_app_op_cond(struct mmc *mmc, unsigned int *ocr)
 {
 	unsigned short cmd;
 	unsigned int  cmdarg;
@@ -314,53 +342,73 @@ static int sd_send_op_cond(struct mmc *mmc)
 	unsigned int  flags;
 	unsigned int  response[4];
 	int ret;
-	int timeout = 1000;
 
-	do {
-		cmd = MMC_CMD_APP_CMD;
-		resp_type = MMC_RSP_R1;
-		cmdarg = 0;
-		flags = 0;
-
-		ret = mmc_cmd(cmd, resp_type, cmdarg, flags, response);
-		if (ret)
-			return ret;
+	cmd = MMC_CMD_APP_CMD;
+	resp_type = MMC_RSP_R1;
+	cmdarg = 0;
+	flags = 0;
 
-		cmd = SD_CMD_APP_SEND_OP_COND;
-		resp_type = MMC_RSP_R3;
+	ret = mmc_cmd(cmd, resp_type, cmdarg, flags, response);
+	if (ret)
+		return ret;
 
-		/*
-		 * Most cards do not answer if some reserved bits
-		 * in the ocr are set. However, Some controller
-		 * can set bit 7 (reserved for low voltages), but
-		 * how to manage low voltages SD card is not yet
-		 * specified.
-		 */
-		cmdarg = mmc->voltages & 0xff8000;
+	cmd = SD_CMD_APP_SEND_OP_COND;
+	resp_type = MMC_RSP_R3;
 
-		if (mmc->version == SD_VERSION_2)
-			cmdarg |= OCR_HCS;
+	/*
+	 * Most cards do not answer if some reserved bits
+	 * in the ocr are set. However, Some controller
+	 * can set bit 7 (reserved for low voltages), but
+	 * how to manage low voltages SD card is not yet
+	 * specified.
+	 */
+	cmdarg = mmc->voltages & 0xff8000;
 
-		flags = 0;
+	if (mmc->version == SD_VERSION_2)
+		cmdarg |= OCR_HCS;
 
-		ret = mmc_cmd(cmd, resp_type, cmdarg, flags, response);
-		if (ret)
-			return ret;
+	flags = 0;
 
-		udelay(1000);
+	ret = mmc_cmd(cmd, resp_type, cmdarg, flags, response);
+	if (ret)
+		return ret;
 
-	} while ((!(response[0] & OCR_BUSY)) && timeout--);
+	*ocr = response[0];
 
-	if (timeout <= 0)
-		return UNUSABLE_ERR;
+	return 0;
+}
 
+/* The card left its power up busy state */
+static void sd_op_cond_ready(struct mmc *mmc, unsigned int ocr)
+{
 	if (mmc->version != SD_VERSION_2)
 		mmc->version = SD_VERSION_1_0;
 
-	mmc->ocr = response[0];
+	mmc->ocr = ocr;
 
 	mmc->high_capacity = ((mmc->ocr & OCR_HCS) == OCR_HCS);
 	mmc->rca = 0;
+}
+
+static int sd_send_op_cond(struct mmc *mmc)
+{
+	unsigned int ocr;
+	int ret;
+	int timeout = 1000;
+
+	do {
+		ret = sd_app_op_cond(mmc, &ocr);
+		if (ret)
+			return ret;
+
+		udelay(1000);
+
+	} while ((!(ocr & OCR_BUSY)) && timeout--);
+
+	if (timeout <= 0)
+		return UNUSABLE_ERR;
+
+	sd_op_cond_ready(mmc, ocr);
 
 	return 0;
 }
@@ -761,6 +809,9 @@ retry_scr:
 	if (mmc->scr[0] & SD_DATA_4BIT)
 		mmc->card_caps |= MMC_MODE_4BIT;
 
+	if (mmc->scr[0] & SD_SCR_CMD23_SUPPORT)
+		mmc->has_cmd23 = 1;
+
 	return 0;
 }
 
@@ -867,7 +918,7 @@ static int mmc_change_freq(struct mmc *mmc)
 	if (mmc->version < MMC_VERSION_4)
 		return 0;
 
-	mmc->card_caps |= MMC_MODE_4BIT;
+	mmc->card_caps |= MMC_MODE_4BIT | MMC_MODE_8BIT;
 
 	ret = mmc_send_ext_csd(mmc, ext_csd);
 	if (ret)
@@ -875,6 +926,11 @@ static int mmc_change_freq(struct mmc *mmc)
 
 	cardtype = ext_csd[196] & 0xf;
 
+	/* Keep the boot configuration for mmc_switch_part() */
+	mmc->part_config = ext_csd[EXT_CSD_PART_CONF];
+	mmc->boot_blocks = ext_csd[EXT_CSD_BOOT_MULT]
+				* EXT_CSD_BOOT_MULT_BLOCKS;
+
 	ret = mmc_switch(mmc, EXT_CSD_CMD_SET_NORMAL, EXT_CSD_HS_TIMING, 1);
 
 	if (ret)
@@ -929,61 +985,42 @@ static int sd_change_freq(struct mmc *mmc)
 	return 0;
 }
 
-static int mmc_set_buswidth_clock(struct mmc *mmc)
+static int mmc_apply_buswidth_clock(struct mmc *mmc)
 {
 	int ret;
 
 	if (IS_SD(mmc)) {
-		/* Read the SD Configuration Register(SCR) */
-		ret = sd_send_scr(mmc);
-		if (ret)
-			return ret;
-
-		/* Version 1.0 doesn't support switching */
-		if (mmc->version != SD_VERSION_1_0)
-			ret = sd_change_freq(mmc);
-			if (ret)
-				return ret;
-	} else {
-		ret = mmc_change_freq(mmc);
-		if (ret)
-			return ret;
-	}
-
-	/* Restrict card's capabilities by what the host can do */
-	mmc->card_caps &= mmc->host_caps;
-
-	if (IS_SD(mmc)) {
-		if (mmc->card_caps & MMC_MODE_4BIT)
+		if (mmc->card_caps & MMC_MODE_4BIT) {
 			ret = sd_set_bus_width_4(mmc);
 			if (ret)
 				return ret;
+		}
 
 		if (mmc->card_caps & MMC_MODE_HS)
 			mci_set_clock(40000000);
 		else
 			mci_set_clock(20000000);
 	} else {
-		if (mmc->card_caps & MMC_MODE_4BIT) {
-			/* Set the card to use 4 bit*/
+		if (mmc->card_caps & MMC_MODE_8BIT) {
+			/* Set the card to use 8 bit*/
 			ret = mmc_switch(mmc, EXT_CSD_CMD_SET_NORMAL,
 					EXT_CSD_BUS_WIDTH,
-					EXT_CSD_BUS_WIDTH_4);
+					EXT_CSD_BUS_WIDTH_8);
 
 			if (ret)
 				return ret;
 
-			mci_set_bus_width(4);
-		} else if (mmc->card_caps & MMC_MODE_8BIT) {
-			/* Set the card to use 8 bit*/
+			mci_set_bus_width(8);
+		} else if (mmc->card_caps & MMC_MODE_4BIT) {
+			/* Set the card to use 4 bit*/
 			ret = mmc_switch(mmc, EXT_CSD_CMD_SET_NORMAL,
 					EXT_CSD_BUS_WIDTH,
-					EXT_CSD_BUS_WIDTH_8);
+					EXT_CSD_BUS_WIDTH_4);
 
 			if (ret)
 				return ret;
 
-			mci_set_bus_width(8);
+			mci_set_bus_width(4);
 		}
 
 		if (mmc->card_caps & MMC_MODE_HS) {
@@ -998,26 +1035,315 @@ static int mmc_set_buswidth_clock(struct mmc *mmc)
 	return 0;
 }
 
+static int mmc_set_buswidth_clock(struct mmc *mmc)
+{
+	int ret;
+
+	if (IS_SD(mmc)) {
+		/* Read the SD Configuration Register(SCR) */
+		ret = sd_send_scr(mmc);
+		if (ret)
+			return ret;
+
+		/* Version 1.0 doesn't support switching */
+		if (mmc->version != SD_VERSION_1_0)
+			ret = sd_change_freq(mmc);
+			if (ret)
+				return ret;
+	} else {
+		/* SET_BLOCK_COUNT is mandatory since MMC 3.1 */
+		if (mmc->version >= MMC_VERSION_3)
+			mmc->has_cmd23 = 1;
+
+		ret = mmc_change_freq(mmc);
+		if (ret)
+			return ret;
+	}
+
+	/* Restrict card's capabilities by what the host can do */
+	mmc->card_caps &= mmc->host_caps;
+
+	return mmc_apply_buswidth_clock(mmc);
+}
+
+#ifdef CONFIG_SDCARD_FAST_INIT
+/*
+ * The identity of the card and the outcome of the capability discovery
+ * are kept in two GPBR registers, so the next boot can skip the SCR,
+ * switch function and EXT_CSD reads when the same card answers CMD2.
+ * The card is known by the manufacturer ID and serial number fields of
+ * its CID, which are kept as they are:
+ *
+ *   GPBR[n]     product serial number
+ *   GPBR[n + 1] MID | boot size mult | PARTITION_CONFIG | magic | flags
+ *
+ * The board picks n, away from the registers its RTC or the next
+ * stages use.
+ */
+#ifndef CONFIG_SYS_MMC_CACHE_GPBR
+#error "CONFIG_SDCARD_FAST_INIT needs the board to define CONFIG_SYS_MMC_CACHE_GPBR"
+#endif
+
+#define MMC_CACHE_PSN		(AT91C_BASE_GPBR + 4 * CONFIG_SYS_MMC_CACHE_GPBR)
+#define MMC_CACHE_INFO		(MMC_CACHE_PSN + 4)
+
+#define MMC_CACHE_MAGIC		0x00000080
+#define MMC_CACHE_MAGIC_MASK	0x000000c0
+
+#define MMC_CACHE_SD		(1 << 0)
+#define MMC_CACHE_CMD23		(1 << 1)
+#define MMC_CACHE_HS		(1 << 2)
+#define MMC_CACHE_HS_52MHZ	(1 << 3)
+#define MMC_CACHE_4BIT		(1 << 4)
+#define MMC_CACHE_8BIT		(1 << 5)
+
+#define MMC_CACHE_MID(info)	((info) >> 24)
+
+static unsigned int mmc_cid_mid(struct mmc *mmc)
+{
+	return mmc->cid[0] >> 24;
+}
+
+/* The serial number sits at CID[55:24] on SD cards, CID[47:16] on MMC */
+static unsigned int mmc_cid_psn(struct mmc *mmc)
+{
+	if (IS_SD(mmc))
+		return (mmc->cid[2] << 8) | (mmc->cid[3] >> 24);
+
+	return (mmc->cid[2] << 16) | (mmc->cid[3] >> 16);
+}
+
+static unsigned int mmc_cache_load(void)
+{
+	unsigned int info = readl(MMC_CACHE_INFO);
+
+	if ((info & MMC_CACHE_MAGIC_MASK) != MMC_CACHE_MAGIC)
+		return 0;
+
+	return info;
+}
+
+static void mmc_cache_invalidate(void)
+{
+	writel(0, MMC_CACHE_INFO);
+}
+
+static void mmc_cache_save(struct mmc *mmc)
+{
+	unsigned int info = MMC_CACHE_MAGIC;
+
+	if (IS_SD(mmc))
+		info |= MMC_CACHE_SD;
+	if (mmc->has_cmd23)
+		info |= MMC_CACHE_CMD23;
+	if (mmc->card_caps & MMC_MODE_HS)
+		info |= MMC_CACHE_HS;
+	if (mmc->card_caps & MMC_MODE_HS_52MHz)
+		info |= MMC_CACHE_HS_52MHZ;
+	if (mmc->card_caps & MMC_MODE_4BIT)
+		info |= MMC_CACHE_4BIT;
+	if (mmc->card_caps & MMC_MODE_8BIT)
+		info |= MMC_CACHE_8BIT;
+
+	/* Boot configuration, without the volatile access bits */
+	info |= (mmc->part_config & ~EXT_CSD_PART_ACCESS_MASK) << 8;
+	info |= (mmc->boot_blocks / EXT_CSD_BOOT_MULT_BLOCKS) << 16;
+	info |= mmc_cid_mid(mmc) << 24;
+
+	writel(mmc_cid_psn(mmc), MMC_CACHE_PSN);
+	writel(info, MMC_CACHE_INFO);
+}
+
+/* Bring the card back to the mode found on a previous boot */
+static int mmc_restore_buswidth_clock(struct mmc *mmc, unsigned int info)
+{
+	unsigned int switch_status[16];
+	int ret;
+
+	mmc->card_caps = 0;
+	if (info & MMC_CACHE_HS)
+		mmc->card_caps |= MMC_MODE_HS;
+	if (info & MMC_CACHE_HS_52MHZ)
+		mmc->card_caps |= MMC_MODE_HS_52MHz;
+	if (info & MMC_CACHE_4BIT)
+		mmc->card_caps |= MMC_MODE_4BIT;
+	if (info & MMC_CACHE_8BIT)
+		mmc->card_caps |= MMC_MODE_8BIT;
+	mmc->card_caps &= mmc->host_caps;
+
+	mmc->has_cmd23 = (info & MMC_CACHE_CMD23) ? 1 : 0;
+	mmc->part_config = (info >> 8) & 0xff;
+	mmc->boot_blocks = ((info >> 16) & 0xff) * EXT_CSD_BOOT_MULT_BLOCKS;
+
+	/* The timing switch is lost at power off, redo it */
+	if (mmc->card_caps & MMC_MODE_HS) {
+		if (IS_SD(mmc))
+			ret = sd_switch(mmc, SD_SWITCH_SWITCH, 0, 1,
+					(unsigned char *)&switch_status);
+		else
+			ret = mmc_switch(mmc, EXT_CSD_CMD_SET_NORMAL,
+					EXT_CSD_HS_TIMING, 1);
+		if (ret)
+			return ret;
+	}
+
+	return mmc_apply_buswidth_clock(mmc);
+}
+#endif /* #ifdef CONFIG_SDCARD_FAST_INIT */
+
 static struct mmc atmel_mmc;
 
+#ifdef CONFIG_BOOT_TASKS
+/*
+ * SD cards take up to one second to leave their power up busy state.
+ * The identification up to ACMD41 runs as a task, started as soon as
+ * the clocks are set, and mmc_initialize() collects its result.
+ */
+enum {
+	SD_PU_POWER,
+	SD_PU_GO_IDLE,
+	SD_PU_IF_COND,
+	SD_PU_OP_COND,
+};
+
+static unsigned int sd_pu_timeout;
+static int sd_pu_started;
+
+static int sd_power_up_run(struct task *task)
+{
+	struct mmc *mmc = &atmel_mmc;
+	unsigned int response[4];
+	unsigned int ocr;
+	int ret;
+
+	switch (task->state) {
+	case SD_PU_POWER:
+		task->state = SD_PU_GO_IDLE;
+		task_sleep(task, 1000);
+		return TASK_AGAIN;
+
+	case SD_PU_GO_IDLE:
+		ret = mmc_cmd(MMC_CMD_GO_IDLE_STATE, MMC_RSP_NONE,
+					0, 0, response);
+		if (ret)
+			break;
+
+		task->state = SD_PU_IF_COND;
+		task_sleep(task, 2000);
+		return TASK_AGAIN;
+
+	case SD_PU_IF_COND:
+		/* Test for SD version 2 */
+		mmc_send_if_cond(mmc);
+
+		sd_pu_timeout = 1000;
+		task->state = SD_PU_OP_COND;
+		return TASK_AGAIN;
+
+	case SD_PU_OP_COND:
+		ret = sd_app_op_cond(mmc, &ocr);
+		if (ret)
+			break;
+
+		if (ocr & OCR_BUSY) {
+			sd_op_cond_ready(mmc, ocr);
+			break;
+		}
+
+		if (--sd_pu_timeout == 0) {
+			ret = UNUSABLE_ERR;
+			break;
+		}
+
+		task_sleep(task, 1000);
+		return TASK_AGAIN;
+
+	default:
+		ret = UNUSABLE_ERR;
+		break;
+	}
+
+	task->result = ret;
+
+	return TASK_DONE;
+}
+
+static struct task sd_power_up = {
+	.name	= "sd power up",
+	.run	= sd_power_up_run,
+};
+
+/* The board calls it once the MCI clock and pins are set up */
+void mmc_power_up_start(void)
+{
+	struct mmc *mmc = &atmel_mmc;
+
+#ifdef CONFIG_SDCARD_FAST_INIT
+	/* A cached eMMC is not probed as an SD card */
+	unsigned int info = mmc_cache_load();
+
+	if (info && !(info & MMC_CACHE_SD))
+		return;
+#endif
+
+	mmc->voltages = MMC_VDD_32_33 | MMC_VDD_33_34;
+	mmc->version = 0;
+
+	mci_init();
+
+	task_start(&sd_power_up);
+	sd_pu_started = 1;
+}
+#endif /* #ifdef CONFIG_BOOT_TASKS */
+
 int mmc_initialize(void)
 {
 	struct mmc *mmc = &atmel_mmc;
 	int ret;
+#ifdef CONFIG_SDCARD_FAST_INIT
+	unsigned int info = mmc_cache_load();
+#endif
 
 	mmc->voltages = MMC_VDD_32_33 | MMC_VDD_33_34;
+	mmc->blocklen_set = 0;
+	mmc->has_cmd23 = 0;
+	mmc->part_config = 0;
+	mmc->boot_blocks = 0;
 #ifdef CONFIG_SDCARD_HS
 	mmc->host_caps = MMC_MODE_4BIT | MMC_MODE_HS;
+#if defined(AT91SAM9X5) || defined(AT91SAM9N12) || defined(AT91SAMA5D3X)
+	/* The HSMCI divider gets close enough to 52MHz */
+	mmc->host_caps |= MMC_MODE_HS_52MHz;
+#endif
 #else
 	mmc->host_caps = MMC_MODE_4BIT;
 #endif
-
-	/* Initialize mci interface */
-	mci_init();
+#ifdef CONFIG_SDCARD_8BIT
+	mmc->host_caps |= MMC_MODE_8BIT;
+#endif
 
 	/* Card Indentification mode */
-	ret = sd_init_card(mmc);
-	if (ret == TIMEOUT) {
+	ret = UNUSABLE_ERR;
+#ifdef CONFIG_BOOT_TASKS
+	/* The card may already be powered up */
+	if (sd_pu_started) {
+		sd_pu_started = 0;
+		ret = task_wait(&sd_power_up);
+	} else
+#endif
+	{
+		/* Initialize mci interface */
+		mci_init();
+
+#ifdef CONFIG_SDCARD_FAST_INIT
+		/* A cached eMMC does not need the SD probe to time out first */
+		if (info && !(info & MMC_CACHE_SD))
+			ret = mmc_init_card(mmc);
+#endif
+		if (ret)
+			ret = sd_init_card(mmc);
+	}
+	if (ret) {
 		ret = mmc_init_card(mmc);
 		if (ret)
 			return UNUSABLE_ERR;
@@ -1028,6 +1354,14 @@ int mmc_initialize(void)
 	if (ret)
 		return ret;
 
+#ifdef CONFIG_SDCARD_FAST_INIT
+	/* Only trust the cache for the very same card */
+	if (info && (((!(info & MMC_CACHE_SD)) != (!IS_SD(mmc)))
+			|| (MMC_CACHE_MID(info) != mmc_cid_mid(mmc))
+			|| (readl(MMC_CACHE_PSN) != mmc_cid_psn(mmc))))
+		info = 0;
+#endif
+
 	/*
 	 * For MMC cards, set the Relative Address.
 	 * For SD cards, get the Relatvie Address.
@@ -1048,10 +1382,119 @@ int mmc_initialize(void)
 		return ret;
 
 	/* Set bus width and clock */
+#ifdef CONFIG_SDCARD_FAST_INIT
+	if (info) {
+		if (mmc_restore_buswidth_clock(mmc, info) == 0)
+			return 0;
+
+		/*
+		 * Stale cache, the card may be left half switched: reset it
+		 * with CMD0 and go through the whole discovery instead
+		 */
+		mmc_cache_invalidate();
+
+		return mmc_initialize();
+	}
+#endif
 	ret = mmc_set_buswidth_clock(mmc);
 	if (ret)
 		return ret;
 
+#ifdef CONFIG_SDCARD_FAST_INIT
+	mmc_cache_save(mmc);
+#endif
+
+	return 0;
+}
+
+#ifdef CONFIG_BOOT_CHAIN
+/*
+ * Only check that a card answers on the slot, the operating condition
+ * polling of the card initialization is left to mmc_initialize(). An
+ * empty slot costs the response time-outs of a few commands, and the
+ * probe gives up when its budget runs out.
+ */
+int mmc_probe(void)
+{
+	unsigned int response[4];
+
+#ifdef CONFIG_BOOT_TASKS
+	/* Leave the card to the power up task, it tells the rest */
+	if (sd_pu_started)
+		return 0;
+#endif
+
+	mci_init();
+
+	/* 74 clocks at the identification clock before the first command */
+	udelay(250);
+
+	if (mmc_cmd(MMC_CMD_GO_IDLE_STATE, MMC_RSP_NONE, 0, 0, response))
+		return -1;
+
+	/* SD version 2 */
+	if (mmc_cmd(SD_CMD_SEND_IF_COND, MMC_RSP_R7, 0x1aa, 0, response) == 0)
+		return 0;
+
+	if (pit_budget_expired())
+		return -1;
+
+	/* SD version 1 */
+	if (mmc_cmd(MMC_CMD_APP_CMD, MMC_RSP_R1, 0, 0, response) == 0)
+		return 0;
+
+	if (pit_budget_expired())
+		return -1;
+
+	/* MMC */
+	if (mmc_cmd(MMC_CMD_SEND_OP_COND, MMC_RSP_R3, 0, 0, response) == 0)
+		return 0;
+
+	return -1;
+}
+#endif /* #ifdef CONFIG_BOOT_CHAIN */
+
+/*
+ * Route the following accesses to the user area (0) or to one of the
+ * eMMC boot partitions (1, 2). The size of the selected area is
+ * returned in nr_blocks if not NULL, 0 meaning unknown.
+ */
+int mmc_switch_part(unsigned int part, unsigned int *nr_blocks)
+{
+	struct mmc *mmc = &atmel_mmc;
+	unsigned char value;
+	int ret;
+
+	if (nr_blocks)
+		*nr_blocks = 0;
+
+	if (IS_SD(mmc) || (mmc->version < MMC_VERSION_4))
+		return part ? UNUSABLE_ERR : 0;
+
+	if (part > EXT_CSD_PART_ACCESS_BOOT2)
+		return UNUSABLE_ERR;
+
+	if (part != EXT_CSD_PART_ACCESS_USER) {
+		if (!mmc->boot_blocks)
+			return UNUSABLE_ERR;
+
+		if (nr_blocks)
+			*nr_blocks = mmc->boot_blocks;
+	}
+
+	if ((mmc->part_config & EXT_CSD_PART_ACCESS_MASK) == part)
+		return 0;
+
+	/* Leave the boot enable and boot ack bits as they are */
+	value = (mmc->part_config & ~EXT_CSD_PART_ACCESS_MASK) | part;
+
+	ret = mmc_switch(mmc, EXT_CSD_CMD_SET_NORMAL,
+				EXT_CSD_PART_CONF, value);
+	if (ret)
+		return ret;
+
+	mmc->part_config = value;
+
 	return 0;
 }
 
@@ -1076,6 +1519,129 @@ static int mmc_set_blocklen(int blocklen)
 	return 0;
 }
 
+#if defined(MCI_USE_DMAC) || defined(MCI_USE_PDC)
+#define MCI_DMA_ERROR_FLAGS	(ERROR_FLAGS \
+				| AT91C_MCI_DCRCE \
+				| AT91C_MCI_OVRE)
+
+/*
+ * Arm the DMA for the first window of len bytes before the read
+ * command is sent, the MCI read proof mode stops the card clock
+ * until the DMA drains the data.
+ */
+static int mci_dma_start(void *dest, unsigned int len)
+{
+#ifdef MCI_USE_DMAC
+	struct dmac_xfer xfer;
+#endif
+
+	if (len > MCI_DMA_MAX_LEN)
+		len = MCI_DMA_MAX_LEN;
+
+#ifdef MCI_USE_DMAC
+
+	mci_writel(MCI_DMA, AT91C_MCI_DMAEN_ENABLE | AT91C_MCI_CHKSIZE_1);
+
+	xfer.src = CONFIG_SYS_BASE_MCI + MCI_RDR;
+	xfer.dst = (unsigned int)dest;
+	xfer.len = len;
+	xfer.width = DMAC_WIDTH_WORD;
+	xfer.type = DMAC_PER_TO_MEM;
+	xfer.per_id = CONFIG_SYS_DMAC_PER_ID_MCI;
+
+	if (dmac_start(DMAC_CH_MCI, &xfer)) {
+		mci_writel(MCI_DMA, 0);
+		return -1;
+	}
+#else
+	unsigned int words = len / 4;
+	unsigned int first;
+
+	first = (words > AT91C_PDC_MAX_COUNT) ? AT91C_PDC_MAX_COUNT : words;
+
+	mci_writel(PERIPH_PTCR, AT91C_PDC_RXTDIS | AT91C_PDC_TXTDIS);
+	mci_writel(MCI_MR, mci_readl(MCI_MR) | AT91C_MCI_PDCMODE);
+
+	mci_writel(PERIPH_RPR, (unsigned int)dest);
+	mci_writel(PERIPH_RCR, first);
+	mci_writel(PERIPH_RNPR, (unsigned int)dest + first * 4);
+	mci_writel(PERIPH_RNCR, words - first);
+
+	mci_writel(PERIPH_PTCR, AT91C_PDC_RXTEN);
+#endif
+	return 0;
+}
+
+static void mci_dma_stop(void)
+{
+#ifdef MCI_USE_DMAC
+	dmac_stop(DMAC_CH_MCI);
+	mci_writel(MCI_DMA, 0);
+#else
+	mci_writel(PERIPH_PTCR, AT91C_PDC_RXTDIS);
+	mci_writel(MCI_MR, mci_readl(MCI_MR) & ~AT91C_MCI_PDCMODE);
+#endif
+}
+
+/* Wait for the current window, the data transfer ends with the last one */
+static int mci_dma_wait(int last)
+{
+	unsigned int status;
+	int done;
+	int ret = 0;
+
+	do {
+		status = mci_readl(MCI_SR);
+		if (status & MCI_DMA_ERROR_FLAGS) {
+			dbg_log(1, "DMA read error, MCI_SR: %d\n\r", status);
+			ret = COMM_ERR;
+			break;
+		}
+#ifdef MCI_USE_DMAC
+		done = dmac_is_done(DMAC_CH_MCI);
+		if ((done > 0) && last)
+			done = !(status & AT91C_MCI_DTIP);
+		else if (done < 0) {
+			ret = COMM_ERR;
+			break;
+		}
+#else
+		done = (status & AT91C_MCI_RXBUFF) ? 1 : 0;
+#endif
+	} while (!done);
+
+	if (ret || last)
+		mci_dma_stop();
+
+	return ret;
+}
+
+/*
+ * Receive len bytes into dest, one DMA window after the other,
+ * the first window was armed by mci_dma_start().
+ */
+static int mci_dma_read(unsigned char *dest, unsigned int len)
+{
+	unsigned int window;
+	int ret;
+
+	for (;;) {
+		window = (len > MCI_DMA_MAX_LEN) ? MCI_DMA_MAX_LEN : len;
+		len -= window;
+
+		ret = mci_dma_wait(len == 0);
+		if (ret || (len == 0))
+			return ret;
+
+		dest += window;
+		if (mci_dma_start(dest, len)) {
+			mci_dma_stop();
+			return COMM_ERR;
+		}
+	}
+}
+#endif /* #if defined(MCI_USE_DMAC) || defined(MCI_USE_PDC) */
+
 static int mmc_stop_transmission(struct mmc *mmc)
 {
 	unsigned short cmd;
@@ -1111,12 +1677,38 @@ static int mmc_read_blocks(struct mmc *mmc,
 	unsigned int  flags;
 	unsigned int  response[4];
 	int ret;
+	int need_stop = 0;
+#ifdef MCI_DMA_MAX_LEN
+	int use_dma = 0;
+#endif
 
 	unsigned int blocklen = mmc->read_bl_len;
 
+	/*
+	 * With a pre-defined block count the card ends the transfer
+	 * itself, which saves the STOP_TRANSMISSION/SEND_STATUS round trip.
+	 */
+	if (blkcnt > 1) {
+		need_stop = 1;
+		if (mmc->has_cmd23) {
+			ret = mmc_cmd(MMC_CMD_SET_BLOCK_COUNT, MMC_RSP_R1,
+					blkcnt, 0, response);
+			if (ret == 0)
+				need_stop = 0;
+			else
+				mmc->has_cmd23 = 0;
+		}
+	}
+
 	/* set block count and block length */
 	mci_set_blkr(blkcnt, blocklen);
 
+#ifdef MCI_DMA_MAX_LEN
+	/* The DMA moves whole words, fall back to PIO for odd buffers */
+	if (!((unsigned int)dest & 0x03) && !(blocklen & 0x03))
+		use_dma = !mci_dma_start(dest, blocklen * blkcnt);
+#endif
+
 	flags = AT91C_MCI_TRCMD_START | AT91C_MCI_TRDIR_READ;
 	if (blkcnt > 1) {
 		cmd = MMC_CMD_READ_MULTIPLE_BLOCK;
@@ -1134,14 +1726,20 @@ static int mmc_read_blocks(struct mmc *mmc,
 	resp_type = MMC_RSP_R1;
 
 	ret = mmc_cmd(cmd, resp_type, cmdarg, flags, response);
+#ifdef MCI_DMA_MAX_LEN
+	if (use_dma) {
+		if (ret)
+			mci_dma_stop();
+		else
+			ret = mci_dma_read(dest, blocklen * blkcnt);
+	} else
+#endif
+	if (!ret)
+		ret = mmc_data_read(mmc, dest, blocklen, blkcnt);
 	if (ret)
 		return 0;
 
-	ret = mmc_data_read(mmc, dest, blocklen, blkcnt);
-	if (ret)
-		return 0;
-
-	if (blkcnt > 1) 
+	if (need_stop)
 		mmc_stop_transmission(mmc);
 
 	return blkcnt;
@@ -1155,8 +1753,12 @@ unsigned int mmc_bread(unsigned int start, unsigned int blkcnt, void *dest)
 	if (blkcnt == 0)
 		return 0;
 
-	if (mmc_set_blocklen(mmc->read_bl_len))
-		return 0;
+	/* The block length does not change during a session */
+	if (!mmc->blocklen_set) {
+		if (mmc_set_blocklen(mmc->read_bl_len))
+			return 0;
+		mmc->blocklen_set = 1;
+	}
 
 	do {
 		cur_blocks = (blocks_todo > MCI_SUPPORT_MAX_BLKS) ? MCI_SUPPORT_MAX_BLKS : blocks_todo;
@@ -29,6 +29,7 @@
 #include "arch/at91_pio.h"
 #include "gpio.h"
 #include "debug.h"
+#include "string.h"
 
 static inline void write_pio(unsigned int offset, const unsigned int value)
 {
@@ -50,46 +51,6 @@ static inline unsigned pin_to_mask(unsigned pin)
 	return 1 << ((pin) % PIO_NUM_IO);
 }
 
-static int pio_set_a_periph(unsigned pin, int use_pullup)
-{
-	unsigned pio = pin_to_controller(pin);
-	unsigned mask = pin_to_mask(pin);
-
-	if (pio >= AT91C_NUM_PIO)
-		return -1;
-
-	write_pio(PIO_IDR(pio), mask);
-	write_pio(use_pullup ? PIO_PPUER(pio) : PIO_PPUDR(pio), mask);
-#ifndef CONFIG_HAS_PIO3
-	write_pio(PIO_ASR(pio), mask);
-#else
-	write_pio(PIO_SP1(pio), read_pio(PIO_SP1(pio)) & ~mask);
-	write_pio(PIO_SP2(pio), read_pio(PIO_SP2(pio)) & ~mask);
-#endif
-	write_pio(PIO_PDR(pio), mask);
-	return 0;
-}
-
-static int pio_set_b_periph(unsigned pin, int use_pullup)
-{
-	unsigned pio = pin_to_controller(pin);
-	unsigned mask = pin_to_mask(pin);
-
-	if (pio >= AT91C_NUM_PIO)
-		return -1;
-
-	write_pio(PIO_IDR(pio), mask);
-	write_pio((use_pullup ? PIO_PPUER(pio) : PIO_PPUDR(pio)), mask);
-#ifndef CONFIG_HAS_PIO3
-	write_pio(PIO_BSR(pio), mask);
-#else
-	write_pio(PIO_SP1(pio), read_pio(PIO_SP1(pio)) | mask);
-	write_pio(PIO_SP2(pio), read_pio(PIO_SP2(pio)) & ~mask);
-#endif
-	write_pio(PIO_PDR(pio), mask);
-	return 0;
-}
-
 int pio_set_gpio_input(unsigned pin, int use_pullup)
 {
 	unsigned pio = pin_to_controller(pin);
@@ -121,7 +82,8 @@ int pio_set_gpio_output(unsigned pin, int value)
 	return 0;
 }
 
-static int pio_set_deglitch(unsigned pin, int is_on)
+#if !defined(at91sam9g10)
+int pio_set_value(unsigned pin, int value)
 {
 	unsigned pio = pin_to_controller(pin);
 	unsigned mask = pin_to_mask(pin);
@@ -129,86 +91,148 @@ static int pio_set_deglitch(unsigned pin, int is_on)
 	if (pio >= AT91C_NUM_PIO)
 		return -1;
 
-	write_pio((is_on ? PIO_IFER(pio) : PIO_IFDR(pio)), mask);
+	write_pio((value ? PIO_SODR(pio) : PIO_CODR(pio)), mask);
 	return 0;
 }
+#endif
 
-static int pio_set_multi_drive(unsigned pin, int is_on)
+int pio_get_value(unsigned pin)
 {
 	unsigned pio = pin_to_controller(pin);
 	unsigned mask = pin_to_mask(pin);
+	unsigned int pdsr;
 
 	if (pio >= AT91C_NUM_PIO)
 		return -1;
 
-	write_pio((is_on ? PIO_MDER(pio) : PIO_MDDR(pio)), mask);
-	return 0;
+	pdsr = read_pio(PIO_PDSR(pio));
+	return ((pdsr & mask) != 0);
 }
 
-#if !defined(at91sam9g10)
-int pio_set_value(unsigned pin, int value)
+/* Pins of one table merged into one mask per register, for one controller */
+struct pio_masks {
+	unsigned int	all;
+	unsigned int	pullup;
+	unsigned int	periph_a;
+	unsigned int	periph_b;
+	unsigned int	input;
+	unsigned int	deglitch;
+	unsigned int	output;
+	unsigned int	opendrain;
+	unsigned int	set;
+};
+
+static void pio_merge(const struct pio_desc *pio_desc, unsigned count,
+			unsigned pio, struct pio_masks *m)
 {
-	unsigned pio = pin_to_controller(pin);
-	unsigned mask = pin_to_mask(pin);
+	unsigned mask;
 
-	if (pio >= AT91C_NUM_PIO)
-		return -1;
+	memset(m, 0, sizeof(*m));
+	for (; count; --count, ++pio_desc) {
+		if (pin_to_controller(pio_desc->pin_num) != pio)
+			continue;
 
-	write_pio((value ? PIO_SODR(pio) : PIO_CODR(pio)), mask);
-	return 0;
-}
+		mask = pin_to_mask(pio_desc->pin_num);
+		m->all |= mask;
+		if (pio_desc->attribute & PIO_PULLUP)
+			m->pullup |= mask;
+
+		if (pio_desc->type == PIO_PERIPH_A)
+			m->periph_a |= mask;
+#if !(defined(at91sam9g10)&&defined(CONFIG_SDCARD))
+		else if (pio_desc->type == PIO_PERIPH_B)
+			m->periph_b |= mask;
+		else if (pio_desc->type == PIO_INPUT) {
+			m->input |= mask;
+			if (pio_desc->attribute & PIO_DEGLITCH)
+				m->deglitch |= mask;
+		} else {
+			m->output |= mask;
+			m->pullup &= ~mask;
+			if (pio_desc->attribute & PIO_OPENDRAIN)
+				m->opendrain |= mask;
+			if (pio_desc->default_value)
+				m->set |= mask;
+		}
 #endif
+	}
+}
 
-int pio_get_value(unsigned pin)
+static inline void write_pio_mask(unsigned int offset, unsigned int mask)
 {
-	unsigned pio = pin_to_controller(pin);
-	unsigned mask = pin_to_mask(pin);
-	unsigned int pdsr;
+	if (mask)
+		write_pio(offset, mask);
+}
 
-	if (pio >= AT91C_NUM_PIO)
-		return -1;
+static void pio_apply(unsigned pio, const struct pio_masks *m)
+{
+	unsigned periph = m->periph_a | m->periph_b;
 
-	pdsr = read_pio(PIO_PDSR(pio));
-	return ((pdsr & mask) != 0);
+	/*
+	 * Same order as the per pin helpers: interrupts and pull-ups first,
+	 * output level before the output enable, function select before PDR.
+	 */
+	write_pio(PIO_IDR(pio), m->all);
+	write_pio_mask(PIO_PPUDR(pio), m->all & ~m->pullup);
+	write_pio_mask(PIO_PPUER(pio), m->pullup);
+#if !(defined(at91sam9g10)&&defined(CONFIG_SDCARD))
+	write_pio_mask(PIO_IFER(pio), m->deglitch);
+	write_pio_mask(PIO_IFDR(pio), m->input & ~m->deglitch);
+	write_pio_mask(PIO_MDER(pio), m->opendrain);
+	write_pio_mask(PIO_MDDR(pio), m->output & ~m->opendrain);
+	write_pio_mask(PIO_SODR(pio), m->set);
+	write_pio_mask(PIO_CODR(pio), m->output & ~m->set);
+	write_pio_mask(PIO_ODR(pio), m->input);
+	write_pio_mask(PIO_OER(pio), m->output);
+#endif
+	if (periph) {
+#ifndef CONFIG_HAS_PIO3
+		write_pio_mask(PIO_ASR(pio), m->periph_a);
+		write_pio_mask(PIO_BSR(pio), m->periph_b);
+#else
+		write_pio(PIO_SP1(pio),
+			(read_pio(PIO_SP1(pio)) & ~m->periph_a) | m->periph_b);
+		write_pio(PIO_SP2(pio), read_pio(PIO_SP2(pio)) & ~periph);
+#endif
+		write_pio(PIO_PDR(pio), periph);
+	}
+	write_pio_mask(PIO_PER(pio), m->input | m->output);
 }
 
 int pio_configure(const struct pio_desc *pio_desc)
 {
+	const struct pio_desc *desc;
+	struct pio_masks masks;
 	unsigned pio, pin = 0;
+	unsigned used = 0;
+	int ret;
 
 	if (pio_desc == 0) return 0;
 
 	/*
-	 * Sets all the pio muxing of the corresponding device as defined in its platform_data struct 
+	 * Sets all the pio muxing of the corresponding device as defined in its platform_data struct.
+	 * The pins are merged per controller so each register is written once per table
+	 * instead of once per pin. As before, a bad entry ends the table.
 	 */
-	while (pio_desc->pin_name) {
-		pio = pin_to_controller(pio_desc->pin_num);
+	for (desc = pio_desc; desc->pin_name; ++desc, ++pin) {
+		pio = pin_to_controller(desc->pin_num);
 		if (pio >= AT91C_NUM_PIO)
-			return 0;
-		else if (pio_desc->type == PIO_PERIPH_A)
-			pio_set_a_periph(pio_desc->pin_num,
-			 	(pio_desc->attribute & PIO_PULLUP) ? 1 : 0);
+			break;
 #if !(defined(at91sam9g10)&&defined(CONFIG_SDCARD))
-		else if (pio_desc->type == PIO_PERIPH_B)
-			pio_set_b_periph(pio_desc->pin_num,
-				(pio_desc->attribute & PIO_PULLUP) ? 1 : 0);
-		else if (pio_desc->type == PIO_INPUT) {
-			pio_set_deglitch(pio_desc->pin_num,
-				(pio_desc->attribute & PIO_DEGLITCH) ? 1 : 0);
-			pio_set_gpio_input(pio_desc->pin_num,
-				(pio_desc->attribute & PIO_PULLUP) ? 1 : 0);
-		} else if (pio_desc->type == PIO_OUTPUT) {
-			pio_set_multi_drive(pio_desc->pin_num,
-				(pio_desc->attribute & PIO_OPENDRAIN) ? 1 : 0);
-			pio_set_gpio_output(pio_desc->pin_num,
-				pio_desc->default_value);
-		}
+		if (desc->type > PIO_OUTPUT)
+#else
+		if (desc->type != PIO_PERIPH_A)
 #endif
-		else
-			return 0;
-		
-		++pin;
-		++pio_desc;
+			break;
+		used |= 1 << pio;
+	}
+	ret = desc->pin_name ? 0 : pin;
+
+	for (pio = 0; pio < AT91C_NUM_PIO; pio++) {
+		if (!(used & (1 << pio)))
+			continue;
+		pio_merge(pio_desc, pin, pio, &masks);
+		pio_apply(pio, &masks);
 	}
-	return pin;
+	return ret;
 }
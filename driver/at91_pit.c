@@ -39,37 +39,54 @@ static inline void pit_writel(unsigned int value, unsigned reg)
 	writel(value, (AT91C_BASE_PITC + reg));
 }
 
-/* time unit: ms */
-int start_intervl_timer(unsigned int time)
+/*
+ * The PIT runs free with its largest period, so PIIR, the periodic
+ * interval counter above the current value, reads as one 32-bit tick
+ * count at MCK/16. It wraps after about 520s at 132MHz.
+ */
+static void pit_init(void)
+{
+	if (!(pit_readl(PIT_MR) & AT91C_PIT_PITEN))
+		pit_writel(AT91C_PIT_PIV | AT91C_PIT_PITEN, PIT_MR);
+}
+
+unsigned int pit_get_ticks(void)
+{
+	pit_init();
+
+	return pit_readl(PIT_PIIR);
+}
+
+/* time unit: us */
+unsigned int pit_us_to_ticks(unsigned int time)
 {
-	unsigned int interval_val;
-	unsigned int reg;
+	return (MASTER_CLOCK / 16 / 1000) * time / 1000;
+}
 
-	interval_val = (MASTER_CLOCK / 16 / 1000) * time;
-	if (interval_val > 0xFFFFF)
-		return -1;
+/* Wraps are fine as long as the deadline is less than ~260s away */
+int pit_ticks_passed(unsigned int ticks)
+{
+	return (int)(pit_get_ticks() - ticks) >= 0;
+}
 
-	reg = interval_val | AT91C_PIT_PITEN;
-	pit_writel(reg, PIT_MR);
+static unsigned int interval_start;
+
+/* time unit: ms */
+int start_intervl_timer(unsigned int time)
+{
+	interval_start = pit_get_ticks();
 
 	return 0;
 }
 
-/* wait_timer unit: ms */
+/* wait_timer unit: ms, counted from start_intervl_timer() */
 /* timer unit: ms */
 unsigned int wait_interval_timer(unsigned int wait_time, unsigned int timer)
 {
-	unsigned int check_counter = wait_time / timer;
-	unsigned int counter;
+	unsigned int ticks = (MASTER_CLOCK / 16 / 1000) * wait_time;
 
-	if (check_counter > 0xFFF)
-		return -1;
-
-	do {
-		counter = pit_readl(PIT_PIIR) >> 20;
-	} while (counter < check_counter);
-
-	pit_writel(0x00, PIT_MR);
+	while ((pit_get_ticks() - interval_start) < ticks)
+		;
 
 	return 0;
 }
@@ -77,23 +94,23 @@ unsigned int wait_interval_timer(unsigned int wait_time, unsigned int timer)
 /* time unit: us */
 int wait_timer(unsigned int time)
 {
-	unsigned int reg;
-	unsigned int interval_val;
-
-	interval_val = ((MASTER_CLOCK / 1000) * time) / 16 / 1000;
-	if (interval_val > 0xFFFFF)
-		return -1;
+	unsigned int deadline = pit_get_ticks() + pit_us_to_ticks(time);
 
-	/* enable PIT */
-	reg = interval_val | AT91C_PIT_PITEN;
-	pit_writel(reg, PIT_MR);
+	while (!pit_ticks_passed(deadline))
+		;
 
-	/* clear bit PITS in PIT_SR */
-	pit_readl(PIT_PIVR);
+	return 0;
+}
 
-	while((pit_readl(PIT_SR) & AT91C_PIT_PITS) == 0);
+/* Probe budget, time unit: us */
+static unsigned int budget_deadline;
 
-	pit_writel(0x00, PIT_MR);
+void pit_budget_start(unsigned int time)
+{
+	budget_deadline = pit_get_ticks() + pit_us_to_ticks(time);
+}
 
-	return 0;
+int pit_budget_expired(void)
+{
+	return pit_ticks_passed(budget_deadline);
 }
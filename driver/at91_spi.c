@@ -34,6 +34,19 @@
 #include "debug.h"
 #include "board.h"
 
+#ifdef CONFIG_DATAFLASH_DMA
+#if defined(AT91SAM9X5) || defined(AT91SAM9N12) || defined(AT91SAMA5D3X)
+#define SPI_USE_DMAC
+#include "dmac.h"
+#else
+#define SPI_USE_PDC
+#include "arch/at91_pdc.h"
+#endif
+
+/* Shorter transfers are not worth setting up the DMA for */
+#define SPI_DMA_MIN_LEN		32
+#endif
+
 #define spi_readl(reg)			\
 	readl(CONFIG_SYS_BASE_SPI + reg)
 
@@ -80,6 +93,11 @@ int at91_spi_init(unsigned int clock, unsigned int mode)
 	spi_writel(SPI_CSR(cs), csrx);
 	spi_writel(SPI_MR, mr);
 
+#ifdef SPI_USE_DMAC
+	dmac_request(DMAC_CH_SPI_RX);
+	dmac_request(DMAC_CH_SPI_TX);
+#endif
+
 	return 0;
 }
 
@@ -97,6 +115,122 @@ void at91_spi_disable(void)
 	spi_writel(SPI_CR, AT91C_SPI_SPIDIS);
 }
 
+#ifdef SPI_DMA_MIN_LEN
+/*
+ * Receive len bytes into buf. The controller has to transmit to
+ * receive, the bytes clocked out are taken from buf itself: the
+ * transmit side always runs ahead of the receive side and the
+ * flash ignores them during a read.
+ */
+#ifdef SPI_USE_DMAC
+/* Waits for both channels, an overrun means bytes were lost on the way */
+static int spi_dmac_wait(void)
+{
+	int tx, rx;
+
+	do {
+		if (spi_readl(SPI_SR) & AT91C_SPI_OVRES)
+			return -1;
+
+		tx = dmac_is_done(DMAC_CH_SPI_TX);
+		rx = dmac_is_done(DMAC_CH_SPI_RX);
+		if ((tx < 0) || (rx < 0))
+			return -1;
+	} while (!tx || !rx);
+
+	if (spi_readl(SPI_SR) & AT91C_SPI_OVRES)
+		return -1;
+
+	return 0;
+}
+
+static int spi_dma_read(unsigned char *buf, unsigned int len)
+{
+	struct dmac_xfer rx, tx;
+	unsigned int max = DMAC_MAX_XFER_LEN(DMAC_WIDTH_BYTE);
+
+	rx.src = CONFIG_SYS_BASE_SPI + SPI_RDR;
+	rx.width = DMAC_WIDTH_BYTE;
+	rx.type = DMAC_PER_TO_MEM;
+	rx.per_id = CONFIG_SYS_DMAC_PER_ID_SPI_RX;
+
+	tx.dst = CONFIG_SYS_BASE_SPI + SPI_TDR;
+	tx.width = DMAC_WIDTH_BYTE;
+	tx.type = DMAC_MEM_TO_PER;
+	tx.per_id = CONFIG_SYS_DMAC_PER_ID_SPI_TX;
+
+	/* Drop a stale overrun flag, SR is cleared on read */
+	(void)spi_readl(SPI_SR);
+
+	while (len) {
+		rx.dst = tx.src = (unsigned int)buf;
+		rx.len = tx.len = (len > max) ? max : len;
+
+		if (dmac_start(DMAC_CH_SPI_RX, &rx))
+			return -1;
+		if (dmac_start(DMAC_CH_SPI_TX, &tx)) {
+			dmac_stop(DMAC_CH_SPI_RX);
+			return -1;
+		}
+
+		if (spi_dmac_wait()) {
+			dmac_stop(DMAC_CH_SPI_TX);
+			dmac_stop(DMAC_CH_SPI_RX);
+			return -1;
+		}
+
+		buf += rx.len;
+		len -= rx.len;
+	}
+
+	return 0;
+}
+#else
+static int spi_dma_read(unsigned char *buf, unsigned int len)
+{
+	unsigned int chunk, first;
+	unsigned int status;
+
+	while (len) {
+		chunk = (len > 2 * AT91C_PDC_MAX_COUNT) ?
+				2 * AT91C_PDC_MAX_COUNT : len;
+		first = (chunk > AT91C_PDC_MAX_COUNT) ?
+				AT91C_PDC_MAX_COUNT : chunk;
+
+		spi_writel(PERIPH_PTCR, AT91C_PDC_RXTDIS | AT91C_PDC_TXTDIS);
+
+		spi_writel(PERIPH_RPR, (unsigned int)buf);
+		spi_writel(PERIPH_RCR, first);
+		spi_writel(PERIPH_RNPR, (unsigned int)buf + first);
+		spi_writel(PERIPH_RNCR, chunk - first);
+
+		spi_writel(PERIPH_TPR, (unsigned int)buf);
+		spi_writel(PERIPH_TCR, first);
+		spi_writel(PERIPH_TNPR, (unsigned int)buf + first);
+		spi_writel(PERIPH_TNCR, chunk - first);
+
+		spi_writel(PERIPH_PTCR, AT91C_PDC_RXTEN | AT91C_PDC_TXTEN);
+
+		do {
+			status = spi_readl(SPI_SR);
+			if (status & AT91C_SPI_OVRES) {
+				spi_writel(PERIPH_PTCR,
+					AT91C_PDC_RXTDIS | AT91C_PDC_TXTDIS);
+				return -1;
+			}
+		} while (!(status & AT91C_SPI_RXBUFF));
+
+		spi_writel(PERIPH_PTCR, AT91C_PDC_RXTDIS | AT91C_PDC_TXTDIS);
+
+		buf += chunk;
+		len -= chunk;
+	}
+
+	return 0;
+}
+#endif /* #ifdef SPI_USE_DMAC */
+#endif /* #ifdef SPI_DMA_MIN_LEN */
+
 int spi_xfer(unsigned int len, const void *dout, 
 		void *din, unsigned long flags)
 {
@@ -128,6 +262,17 @@ int spi_xfer(unsigned int len, const void *dout,
 		spi_readl(SPI_SR);
 	}
 
+#ifdef SPI_DMA_MIN_LEN
+	/* Long reads: data phase by DMA, CS stays asserted */
+	if (rxp && !txp && (len >= SPI_DMA_MIN_LEN)) {
+		if (spi_dma_read(rxp, len)) {
+			spi_cs_deactivate();
+			return -1;
+		}
+		goto out;
+	}
+#endif
+
 	for (len_tx = 0, len_rx = 0; len_rx < len; ) {
 		/* send data */
 		if (len_tx < len) {
@@ -0,0 +1,184 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "common.h"
+#include "hardware.h"
+#include "board.h"
+#include "string.h"
+#include "pit_timer.h"
+#include "dataflash.h"
+#include "nandflash.h"
+#include "sdcard.h"
+#include "flash.h"
+#include "boot_media.h"
+
+#include "debug.h"
+
+/*
+ * The memory selected as flash memory technology reads the image from
+ * IMG_ADDRESS, the media chained behind it use their own offset.
+ */
+#ifdef CONFIG_CHAIN_DATAFLASH
+#define DATAFLASH_OFFSET	CHAIN_DATAFLASH_OFFSET
+#else
+#define DATAFLASH_OFFSET	IMG_ADDRESS
+#endif
+
+#ifdef CONFIG_CHAIN_NANDFLASH
+#define NANDFLASH_OFFSET	CHAIN_NANDFLASH_OFFSET
+#else
+#define NANDFLASH_OFFSET	IMG_ADDRESS
+#endif
+
+#ifdef CONFIG_CHAIN_SDCARD
+#ifdef CHAIN_SDCARD_OFFSET
+#define SDCARD_OFFSET		CHAIN_SDCARD_OFFSET
+#else
+#define SDCARD_OFFSET		0
+#endif
+#elif defined(CONFIG_SDCARD_RAW)
+#define SDCARD_OFFSET		IMG_ADDRESS
+#else
+#define SDCARD_OFFSET		0	/* loaded by file name */
+#endif
+
+static const struct boot_media media_table[] = {
+#ifdef CONFIG_DATAFLASH
+	{
+		.name	= "dataflash",
+		.probe	= dataflash_probe,
+		.load	= load_dataflash,
+		.budget	= DATAFLASH_PROBE_BUDGET,
+		.offset	= DATAFLASH_OFFSET,
+	},
+#endif
+#ifdef CONFIG_NANDFLASH
+	{
+		.name	= "nandflash",
+		.probe	= nandflash_probe,
+		.load	= load_nandflash,
+		.budget	= NANDFLASH_PROBE_BUDGET,
+		.offset	= NANDFLASH_OFFSET,
+	},
+#endif
+#ifdef CONFIG_SDCARD
+	{
+		.name	= "sdcard",
+		.probe	= sdcard_probe,
+		.load	= load_sdcard,
+		.budget	= SDCARD_PROBE_BUDGET,
+		.offset	= SDCARD_OFFSET,
+	},
+#endif
+#ifdef CONFIG_FLASH
+	/* We are running from it, it is there */
+	{
+		.name	= "flash",
+		.probe	= NULL,
+#ifdef CONFIG_NORFLASH_XIP
+		.load	= norflash_xip_image,
+#else
+		.load	= load_norflash,
+#endif
+		.budget	= 0,
+		.offset	= IMG_ADDRESS,
+	},
+#endif
+};
+
+static const struct boot_media *find_media(const char *name,
+					unsigned int len,
+					unsigned int *tried)
+{
+	unsigned int i;
+
+	for (i = 0; i < ARRAY_SIZE(media_table); i++) {
+		if (*tried & (1 << i))
+			continue;
+
+		if ((strlen(media_table[i].name) == len)
+				&& (strncmp(media_table[i].name, name, len) == 0)) {
+			*tried |= 1 << i;
+			return &media_table[i];
+		}
+	}
+
+	return NULL;
+}
+
+static int media_probe(const struct boot_media *media)
+{
+	if (!media->probe)
+		return 0;
+
+	pit_budget_start(media->budget);
+
+	return media->probe();
+}
+
+/*
+ * Walk the boot order, the selected memory first, then the chained
+ * media. A medium which does not answer its probe in time is skipped,
+ * one which fails to load the image hands over to the next one.
+ */
+int load_boot_media(struct image_info *img_info)
+{
+	const struct boot_media *media;
+	const char *order = BOOT_CHAIN_ORDER;
+	unsigned int length = img_info->length;
+	unsigned int tried = 0;
+	unsigned int len;
+	int ret;
+
+	while (*order) {
+		while (*order == ' ')
+			order++;
+
+		for (len = 0; order[len] && (order[len] != ' '); len++)
+			;
+
+		media = find_media(order, len, &tried);
+		order += len;
+		if (!media)
+			continue;
+
+		if (media_probe(media)) {
+			dbg_log(1, "%s: not found\n\r", media->name);
+			continue;
+		}
+
+		dbg_log(1, "Boot media: %s\n\r", media->name);
+
+		img_info->offset = media->offset;
+		img_info->length = length;
+		ret = media->load(img_info);
+		if (ret != -1)
+			return ret;
+	}
+
+	return -1;
+}
@@ -27,6 +27,9 @@
  */
 #include "hardware.h"
 #include "arch/at91_dbgu.h"
+#ifdef CONFIG_DBGU_ASYNC
+#include "arch/at91_pdc.h"
+#endif
 
 static inline void write_dbgu(unsigned int offset, const unsigned int value)
 {
@@ -38,6 +41,44 @@ static inline unsigned int read_dbgu(unsigned int offset)
 	return readl(offset + AT91C_BASE_DBGU);
 }
 
+#ifdef CONFIG_DBGU_ASYNC
+/*
+ * The messages are queued in a ring buffer and sent by the PDC. Nothing
+ * runs in the background to queue more, so every print and the flush
+ * hand the pending bytes to the PDC once it is idle. Only the current
+ * pointer/counter pair is used, so the PDC never races a reload.
+ */
+#define DBGU_TX_BUF_SIZE	512	/* power of 2 */
+
+static char dbgu_tx_buf[DBGU_TX_BUF_SIZE];
+static unsigned int dbgu_tx_head;	/* queued */
+static unsigned int dbgu_tx_sent;	/* handed to the PDC */
+
+/* Bytes the PDC has fetched */
+static unsigned int dbgu_tx_done(void)
+{
+	return dbgu_tx_sent - read_dbgu(PERIPH_TCR);
+}
+
+static void dbgu_tx_kick(void)
+{
+	unsigned int start = dbgu_tx_sent & (DBGU_TX_BUF_SIZE - 1);
+	unsigned int len = dbgu_tx_head - dbgu_tx_sent;
+
+	if (!len || read_dbgu(PERIPH_TCR))
+		return;
+
+	/* Up to the end of the buffer, the rest goes with the next kick */
+	if (len > DBGU_TX_BUF_SIZE - start)
+		len = DBGU_TX_BUF_SIZE - start;
+
+	write_dbgu(PERIPH_TPR, (unsigned int)&dbgu_tx_buf[start]);
+	write_dbgu(PERIPH_TCR, len);
+
+	dbgu_tx_sent += len;
+}
+#endif /* #ifdef CONFIG_DBGU_ASYNC */
+
 void dbgu_init(unsigned int baudrate)
 {
 	/* Disable interrupts */
@@ -54,8 +95,42 @@ void dbgu_init(unsigned int baudrate)
 
 	/* Enable RX and Tx */
 	write_dbgu(DBGU_CR, AT91C_DBGU_RXEN | AT91C_DBGU_TXEN);
+
+#ifdef CONFIG_DBGU_ASYNC
+	dbgu_tx_head = 0;
+	dbgu_tx_sent = 0;
+	write_dbgu(PERIPH_TCR, 0);
+	write_dbgu(PERIPH_TNCR, 0);
+	write_dbgu(PERIPH_PTCR, AT91C_PDC_TXTEN);
+#endif
 }
 
+#ifdef CONFIG_DBGU_ASYNC
+void dbgu_print(const char *ptr)
+{
+	while (*ptr != '\0') {
+		/* Only stall when the buffer is full */
+		while ((dbgu_tx_head - dbgu_tx_done()) >= DBGU_TX_BUF_SIZE)
+			dbgu_tx_kick();
+
+		dbgu_tx_buf[dbgu_tx_head++ & (DBGU_TX_BUF_SIZE - 1)] = *ptr++;
+	}
+
+	dbgu_tx_kick();
+}
+
+void dbgu_flush(void)
+{
+	while (dbgu_tx_done() != dbgu_tx_head)
+		dbgu_tx_kick();
+
+	/*
+	 * Wait for the last character to leave the shift register. The PDC
+	 * transmitter stays enabled, the flush may be followed by more prints.
+	 */
+	while (!(read_dbgu(DBGU_CSR) & AT91C_DBGU_TXEMPTY)) ;
+}
+#else
 void dbgu_print(const char *ptr)
 {
 	int i = 0;
@@ -67,6 +142,13 @@ void dbgu_print(const char *ptr)
 	}
 }
 
+void dbgu_flush(void)
+{
+	/* Wait for the last character to leave the shift register */
+	while (!(read_dbgu(DBGU_CSR) & AT91C_DBGU_TXEMPTY)) ;
+}
+#endif /* #ifdef CONFIG_DBGU_ASYNC */
+
 char dbgu_getc(void)
 {
 	while (!(read_dbgu(DBGU_CSR) & AT91C_DBGU_RXRDY)) ;
@@ -33,6 +33,7 @@
 #include "arch/at91_ccfg.h"
 #include "debug.h"
 #include "ddramc.h"
+#include "dram_timing.h"
 
 /* write DDRC register */
 static void write_ddramc(unsigned int address,
@@ -281,3 +282,57 @@ int ddram_initialize(unsigned int base_address,
 
 	return 0;
 }
+
+/*
+ * Fill RTR and T0PR..T2PR with the tightest values the memory allows at
+ * the given MCK. The geometry in MDR/CR is left to the board.
+ */
+int ddramc_timing(struct ddramc_register *ddramc_config,
+		const struct dram_timing *timing,
+		unsigned int mck)
+{
+	int saturated = 0;
+
+	ddramc_config->rtr = dram_field(DRAM_REFRESH_COUNT(timing->trefi, mck),
+					AT91C_DDRC2_COUNT, &saturated);
+
+	ddramc_config->t0pr
+		= dram_field(DRAM_NS_TO_CYCLES(timing->tras, mck),
+				AT91C_DDRC2_TRAS, &saturated)
+		| dram_field(DRAM_NS_TO_CYCLES(timing->trcd, mck),
+				AT91C_DDRC2_TRCD, &saturated)
+		| dram_field(DRAM_NS_TO_CYCLES(timing->twr, mck),
+				AT91C_DDRC2_TWR, &saturated)
+		| dram_field(DRAM_NS_TO_CYCLES(timing->trc, mck),
+				AT91C_DDRC2_TRC, &saturated)
+		| dram_field(DRAM_NS_TO_CYCLES(timing->trp, mck),
+				AT91C_DDRC2_TRP, &saturated)
+		| dram_field(DRAM_NS_TO_CYCLES(timing->trrd, mck),
+				AT91C_DDRC2_TRRD, &saturated)
+		| dram_field(timing->twtr, AT91C_DDRC2_TWTR, &saturated)
+		| dram_field(timing->tmrd, AT91C_DDRC2_TMRD, &saturated);
+
+	ddramc_config->t1pr
+		= dram_field(DRAM_NS_TO_CYCLES(timing->trfc, mck),
+				AT91C_DDRC2_TRFC, &saturated)
+		| dram_field(DRAM_NS_TO_CYCLES(timing->txsnr, mck),
+				AT91C_DDRC2_TXSNR, &saturated)
+		| dram_field(timing->txsrd, AT91C_DDRC2_TXSRD, &saturated)
+		| dram_field(timing->txp, AT91C_DDRC2_TXP, &saturated);
+
+	ddramc_config->t2pr
+		= dram_field(timing->txard, AT91C_DDRC2_TXARD, &saturated)
+		| dram_field(timing->txards, AT91C_DDRC2_TXARDS, &saturated)
+		| dram_field(DRAM_NS_TO_CYCLES(timing->trpa, mck),
+				AT91C_DDRC2_TRPA, &saturated)
+		| dram_field(timing->trtp, AT91C_DDRC2_TRTP, &saturated)
+		| dram_field(DRAM_NS_TO_CYCLES(timing->tfaw, mck),
+				AT91C_DDRC2_TFAW, &saturated);
+
+	if (saturated) {
+		dbg_log(1, "DDRAM: timings out of range at %d Hz\n\r", mck);
+		return -1;
+	}
+
+	return 0;
+}
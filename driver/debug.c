@@ -30,6 +30,7 @@
 #include <stdio.h>
 #include <stdarg.h>
 
+#ifndef CONFIG_DEBUG_TRACE
 #define MAX_BUFFER	128
 
 static char dbg_buf[MAX_BUFFER];
@@ -127,3 +128,88 @@ int dbg_log(const char level, const char *fmt_str, ...)
 
 	return 0;
 }
+#else /* #ifndef CONFIG_DEBUG_TRACE */
+
+#define TRACE_MAGIC	0x45435254	/* "TRCE" */
+#define TRACE_WORDS	(DEBUG_TRACE_SIZE / 4)
+
+/*
+ * A record is the message ID, with the argument count in the top byte,
+ * followed by the arguments. Messages come before the DRAM is set up,
+ * so the log is kept in SRAM and only copied out by dbg_trace_flush().
+ */
+static unsigned int trace_buf[TRACE_WORDS];
+static unsigned int trace_len;
+static unsigned int trace_lost;
+
+int dbg_trace(const char *fmt_id, unsigned int nargs, ...)
+{
+	va_list ap;
+
+	if ((trace_len + 1 + nargs) > TRACE_WORDS) {
+		trace_lost++;
+		return -1;
+	}
+
+	trace_buf[trace_len++] = (nargs << 24) | (unsigned int)fmt_id;
+
+	va_start(ap, nargs);
+	while (nargs--)
+		trace_buf[trace_len++] = va_arg(ap, unsigned int);
+	va_end(ap);
+
+	return 0;
+}
+
+#ifdef CONFIG_DEBUG_TRACE_DUMP
+static void trace_dump_word(char *p, unsigned int data)
+{
+	int i;
+
+	for (i = 7; i >= 0; i--, data >>= 4)
+		p[i] = ((data & 0xF) < 10) ?
+			(data & 0xF) + '0' : (data & 0xF) - 10 + 'a';
+}
+
+/* "#T " lines of eight words, picked out of a console capture */
+static void trace_dump(unsigned int *log, unsigned int words)
+{
+	char line[3 + 8 * 9 + 3];
+	unsigned int i, n;
+
+	for (i = 0; i < words; i += n) {
+		char *p = line;
+
+		*p++ = '#';
+		*p++ = 'T';
+		for (n = 0; (n < 8) && ((i + n) < words); n++) {
+			*p++ = ' ';
+			trace_dump_word(p, log[i + n]);
+			p += 8;
+		}
+		*p++ = '\n';
+		*p++ = '\r';
+		*p = '\0';
+
+		dbgu_print(line);
+	}
+}
+#endif
+
+/* Leave the log in DRAM for the next stage, header first */
+void dbg_trace_flush(void)
+{
+	unsigned int *log = (unsigned int *)DEBUG_TRACE_ADDR;
+	unsigned int i;
+
+	log[0] = TRACE_MAGIC;
+	log[1] = trace_len;
+	log[2] = trace_lost;
+	for (i = 0; i < trace_len; i++)
+		log[3 + i] = trace_buf[i];
+
+#ifdef CONFIG_DEBUG_TRACE_DUMP
+	trace_dump(log, 3 + trace_len);
+#endif
+}
+#endif /* #ifndef CONFIG_DEBUG_TRACE */
@@ -0,0 +1,127 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "common.h"
+#include "hardware.h"
+#include "board.h"
+#include "debug.h"
+#include "pit_timer.h"
+#include "dram_bench.h"
+#include "dram_kernels.h"
+
+#define CP15_ICACHE	(1 << 12)
+
+extern unsigned int get_cp15(void);
+extern void set_cp15(unsigned int value);
+
+static char *utoa(unsigned int value, char *end)
+{
+	*--end = '\0';
+	do {
+		*--end = '0' + (value % 10);
+		value /= 10;
+	} while (value);
+
+	return end;
+}
+
+static void bench_report(const char *name, unsigned int value,
+			const char *unit)
+{
+	char buf[12];
+
+	dbg_log(1, "  %s: %s %s\n\r",
+		name, utoa(value, buf + sizeof(buf)), unit);
+}
+
+/* PIT ticks run at MCK/16 */
+static unsigned int ticks_to_us(unsigned int ticks)
+{
+	return (ticks * 16) / (MASTER_CLOCK / 1000000);
+}
+
+/* Bytes per us are MB/s */
+static unsigned int bench_mbps(unsigned int bytes, unsigned int ticks)
+{
+	unsigned int us = ticks_to_us(ticks);
+
+	return us ? bytes / us : 0;
+}
+
+static void bench_run(unsigned int *base, unsigned int size)
+{
+	unsigned int words = size / sizeof(unsigned int);
+	unsigned int slots;
+	unsigned int start, ticks;
+
+	start = pit_get_ticks();
+	dram_write(base, words);
+	ticks = pit_get_ticks() - start;
+	bench_report("write", bench_mbps(size, ticks), "MB/s");
+
+	start = pit_get_ticks();
+	dram_read(base, words);
+	ticks = pit_get_ticks() - start;
+	bench_report("read", bench_mbps(size, ticks), "MB/s");
+
+	start = pit_get_ticks();
+	dram_copy(base + words / 2, base, words / 2);
+	ticks = pit_get_ticks() - start;
+	bench_report("copy", bench_mbps(size / 2, ticks), "MB/s");
+
+	slots = dram_chase_setup(base, size);
+	start = pit_get_ticks();
+	dram_chase(base, slots);
+	ticks = pit_get_ticks() - start;
+	bench_report("latency",
+		(ticks_to_us(ticks) * 1000) / slots, "ns");
+}
+
+/*
+ * The D-cache needs the MMU, which the bootstrap leaves off, so DRAM
+ * data accesses are uncached either way. The I-cache only matters for
+ * the kernels running from SRAM, it shows the loop overhead.
+ */
+void dram_bench(void)
+{
+	unsigned int *base = (unsigned int *)DRAM_BENCH_ADDR;
+	unsigned int size = DRAM_BENCH_SIZE;
+	unsigned int cp15 = get_cp15();
+
+	dbg_log(1, "DRAM benchmark at %d, %d bytes\n\r",
+		(unsigned int)base, size);
+
+	dbg_log(1, "I-cache off\n\r");
+	set_cp15(cp15 & ~CP15_ICACHE);
+	bench_run(base, size);
+
+	dbg_log(1, "I-cache on\n\r");
+	set_cp15(cp15 | CP15_ICACHE);
+	bench_run(base, size);
+
+	set_cp15(cp15);
+}
@@ -0,0 +1,96 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "dram_kernels.h"
+
+/*
+ * The kernels go through volatile pointers, so the compiler neither
+ * drops the accesses nor turns them into memset()/memcpy() calls.
+ */
+void dram_write(volatile unsigned int *p, unsigned int words)
+{
+	for (; words >= 8; words -= 8, p += 8) {
+		p[0] = words; p[1] = words; p[2] = words; p[3] = words;
+		p[4] = words; p[5] = words; p[6] = words; p[7] = words;
+	}
+}
+
+unsigned int dram_read(const volatile unsigned int *p, unsigned int words)
+{
+	unsigned int acc = 0;
+
+	for (; words >= 8; words -= 8, p += 8)
+		acc += p[0] + p[1] + p[2] + p[3] + p[4] + p[5] + p[6] + p[7];
+
+	return acc;
+}
+
+void dram_copy(volatile unsigned int *dst,
+		const volatile unsigned int *src,
+		unsigned int words)
+{
+	for (; words >= 8; words -= 8, dst += 8, src += 8) {
+		dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] = src[3];
+		dst[4] = src[4]; dst[5] = src[5]; dst[6] = src[6]; dst[7] = src[7];
+	}
+}
+
+#define CHASE_SLOT(base, n) \
+	((void * volatile *)((char *)(base) + (n) * DRAM_CHASE_SLOT))
+
+/*
+ * Link the largest power of two number of slots that fits in size in a
+ * pseudo random cycle and return that number. A power of two modulus
+ * LCG with a = 1 mod 4 and c odd has a full period, so every slot is
+ * visited.
+ */
+unsigned int dram_chase_setup(void *base, unsigned int size)
+{
+	unsigned int slots, i, cur = 0, next;
+
+	for (slots = 1; slots * 2 <= size / DRAM_CHASE_SLOT; slots *= 2)
+		;
+
+	for (i = 0; i < slots; i++) {
+		next = (cur * 1664525 + 1013904223) & (slots - 1);
+		*CHASE_SLOT(base, cur) = (void *)CHASE_SLOT(base, next);
+		cur = next;
+	}
+
+	return slots;
+}
+
+/* Follow the chain, each load depends on the previous one */
+void *dram_chase(void *base, unsigned int slots)
+{
+	void * volatile *p = base;
+
+	while (slots--)
+		p = (void * volatile *)*p;
+
+	return (void *)p;
+}
@@ -8,7 +8,9 @@ COBJS-$(CONFIG_DEBUG)		+= $(DRIVERS_SRC)/dbgu.o
 COBJS-$(CONFIG_DEBUG)		+= $(DRIVERS_SRC)/debug.o
 
 COBJS-$(CONFIG_SCLK)		+= $(DRIVERS_SRC)/at91_slowclk.o
-COBJS-$(CONFIG_SCLK)		+= $(DRIVERS_SRC)/at91_pit.o
+ifneq ($(CONFIG_SCLK)$(CONFIG_BOOT_CHAIN)$(CONFIG_BOOT_TASKS)$(CONFIG_DRAM_BENCH),)
+COBJS-y				+= $(DRIVERS_SRC)/at91_pit.o
+endif
 
 COBJS-y				+= $(DRIVERS_SRC)/at91_pio.o
 COBJS-y				+= $(DRIVERS_SRC)/pmc.o
@@ -18,9 +20,17 @@ COBJS-$(CONFIG_USER_HW_INIT)	+= $(DRIVERS_SRC)/hw_init_hook.o
 COBJS-$(CONFIG_SDRAM)		+= $(DRIVERS_SRC)/sdramc.o
 COBJS-$(CONFIG_SDDRC)		+= $(DRIVERS_SRC)/sddrc.o
 COBJS-$(CONFIG_DDR2)		+= $(DRIVERS_SRC)/ddramc.o
+COBJS-$(CONFIG_DRAM_BENCH)	+= $(DRIVERS_SRC)/dram_bench.o
+COBJS-$(CONFIG_DRAM_BENCH)	+= $(DRIVERS_SRC)/dram_kernels.o
+
+COBJS-$(CONFIG_DMAC)		+= $(DRIVERS_SRC)/at91_dmac.o
 
 COBJS-$(CONFIG_SDCARD)		+= $(DRIVERS_SRC)/at91_mci.o
+ifneq ($(CONFIG_SDCARD_RAW)$(CONFIG_SDCARD_EXT4),)
+COBJS-$(CONFIG_SDCARD)		+= $(DRIVERS_SRC)/sdcard_raw.o
+else
 COBJS-$(CONFIG_SDCARD)		+= $(DRIVERS_SRC)/sdcard.o
+endif
 
 ifeq ($(CONFIG_BOARD), "at91sam9260ek")
 COBJS-$(CONFIG_NANDFLASH)	+= $(DRIVERS_SRC)/nandflash_9260.o
@@ -34,6 +44,9 @@ COBJS-$(CONFIG_DATAFLASH)	+= $(DRIVERS_SRC)/serial_flash.o
 
 COBJS-$(CONFIG_FLASH)		+= $(DRIVERS_SRC)/flash.o
 
+COBJS-$(CONFIG_BOOT_CHAIN)	+= $(DRIVERS_SRC)/boot_media.o
+COBJS-$(CONFIG_BOOT_TASKS)	+= $(DRIVERS_SRC)/task.o
+
 COBJS-$(CONFIG_LOAD_LINUX)	+= $(DRIVERS_SRC)/load_kernel.o
 
 # Currently, 9x5 only
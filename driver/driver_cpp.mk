@@ -14,6 +14,12 @@ ifeq ($(CONFIG_DDR2),y)
 CPPFLAGS += -DCONFIG_DDR2
 endif
 
+ifeq ($(CONFIG_DRAM_BENCH),y)
+CPPFLAGS += -DCONFIG_DRAM_BENCH
+CPPFLAGS += -DDRAM_BENCH_ADDR=$(DRAM_BENCH_ADDR)
+CPPFLAGS += -DDRAM_BENCH_SIZE=$(DRAM_BENCH_SIZE)
+endif
+
 # Support for PSRAM on SAM9263EK EBI1
 
 ifeq ($(CONFIG_PSRAM),y)
@@ -66,19 +72,122 @@ ifeq ($(CONFIG_FLASH),y)
 CPPFLAGS += -DCONFIG_FLASH
 endif
 
+ifeq ($(CONFIG_BOOT_CHAIN),y)
+CPPFLAGS += -DCONFIG_BOOT_CHAIN
+CPPFLAGS += -DBOOT_CHAIN_ORDER="\"$(MEMORY) $(BOOT_CHAIN_ORDER)\""
+CPPFLAGS += -DDATAFLASH_PROBE_BUDGET=$(DATAFLASH_PROBE_BUDGET)
+CPPFLAGS += -DNANDFLASH_PROBE_BUDGET=$(NANDFLASH_PROBE_BUDGET)
+CPPFLAGS += -DSDCARD_PROBE_BUDGET=$(SDCARD_PROBE_BUDGET)
+endif
+
+ifeq ($(CONFIG_CHAIN_DATAFLASH),y)
+CPPFLAGS += -DCONFIG_CHAIN_DATAFLASH
+CPPFLAGS += -DCHAIN_DATAFLASH_OFFSET=$(CHAIN_DATAFLASH_OFFSET)
+endif
+
+ifeq ($(CONFIG_CHAIN_NANDFLASH),y)
+CPPFLAGS += -DCONFIG_CHAIN_NANDFLASH
+CPPFLAGS += -DCHAIN_NANDFLASH_OFFSET=$(CHAIN_NANDFLASH_OFFSET)
+endif
+
+ifeq ($(CONFIG_CHAIN_SDCARD),y)
+CPPFLAGS += -DCONFIG_CHAIN_SDCARD
+ifneq ($(CHAIN_SDCARD_OFFSET),)
+CPPFLAGS += -DCHAIN_SDCARD_OFFSET=$(CHAIN_SDCARD_OFFSET)
+endif
+endif
+
+ifeq ($(CONFIG_NORFLASH_PAGE_MODE),y)
+CPPFLAGS += -DCONFIG_NORFLASH_PAGE_MODE
+CPPFLAGS += -DNORFLASH_TPA=$(NORFLASH_TPA)
+endif
+
+ifeq ($(CONFIG_NORFLASH_DMA),y)
+CPPFLAGS += -DCONFIG_NORFLASH_DMA
+endif
+
+ifeq ($(CONFIG_NORFLASH_XIP),y)
+CPPFLAGS += -DCONFIG_NORFLASH_XIP
+endif
+
 ifeq ($(CONFIG_LOAD_LINUX),y)
 CPPFLAGS += -DCONFIG_LOAD_LINUX
 endif
 
+ifeq ($(CONFIG_DMAC),y)
+CPPFLAGS += -DCONFIG_DMAC
+endif
+
 ifeq ($(CONFIG_SDCARD_HS),y)
 CPPFLAGS += -DCONFIG_SDCARD_HS
 endif
 
+ifeq ($(CONFIG_SDCARD_RAW),y)
+CPPFLAGS += -DCONFIG_SDCARD_RAW
+endif
+
+ifeq ($(CONFIG_SDCARD_EXT4),y)
+CPPFLAGS += -DCONFIG_SDCARD_EXT4
+endif
+
+ifeq ($(CONFIG_SDCARD_PART),y)
+CPPFLAGS += -DCONFIG_SDCARD_PART
+CPPFLAGS += -DSDCARD_PART_NUM=$(SDCARD_PART_NUM)
+CPPFLAGS += -DSDCARD_PART_TYPE="\"$(SDCARD_PART_TYPE)\""
+endif
+
+ifeq ($(CONFIG_SDCARD_EMMC_BOOT),y)
+CPPFLAGS += -DCONFIG_SDCARD_EMMC_BOOT
+CPPFLAGS += -DEMMC_BOOT_PART=$(EMMC_BOOT_PART)
+endif
+
+ifeq ($(CONFIG_SDCARD_8BIT),y)
+CPPFLAGS += -DCONFIG_SDCARD_8BIT
+endif
+
+ifeq ($(CONFIG_SDCARD_CACHE),y)
+CPPFLAGS += -DCONFIG_SDCARD_CACHE
+CPPFLAGS += -DSDCARD_CACHE_LINES=$(SDCARD_CACHE_LINES)
+CPPFLAGS += -DSDCARD_CACHE_RA=$(SDCARD_CACHE_RA)
+ifneq ($(SDCARD_CACHE_ADDR),)
+CPPFLAGS += -DSDCARD_CACHE_ADDR=$(SDCARD_CACHE_ADDR)
+endif
+endif
+
+ifeq ($(CONFIG_SDCARD_FAST_INIT),y)
+CPPFLAGS += -DCONFIG_SDCARD_FAST_INIT
+endif
+
+ifeq ($(CONFIG_SDCARD_DMA),y)
+CPPFLAGS += -DCONFIG_SDCARD_DMA
+endif
+
+ifeq ($(CONFIG_ONEWIRE_CACHE),y)
+CPPFLAGS += -DCONFIG_ONEWIRE_CACHE
+endif
+
+ifeq ($(CONFIG_BOOT_TASKS),y)
+CPPFLAGS += -DCONFIG_BOOT_TASKS
+endif
+
 # Dataflash support
 ifeq ($(CONFIG_DATAFLASH_RECOVERY),y)
 CPPFLAGS += -DCONFIG_DATAFLASH_RECOVERY
 endif
 
+ifeq ($(CONFIG_DATAFLASH_AUTOTUNE),y)
+CPPFLAGS += -DCONFIG_DATAFLASH_AUTOTUNE
+CPPFLAGS += -DAT91C_SPI_MAX_CLK=$(SPI_MAX_CLK)
+endif
+
+ifeq ($(CONFIG_DATAFLASH_DMA),y)
+CPPFLAGS += -DCONFIG_DATAFLASH_DMA
+endif
+
+ifeq ($(CONFIG_DATAFLASH_JEDEC),y)
+CPPFLAGS += -DCONFIG_DATAFLASH_JEDEC
+endif
+
 ifeq ($(CONFIG_SMALL_DATAFLASH),y)
 CPPFLAGS += -DCONFIG_SMALL_DATAFLASH
 endif
@@ -93,6 +202,11 @@ CPPFLAGS += -DAT91C_SPI_CLK=$(SPI_CLK)
 CPPFLAGS += -DAT91C_SPI_PCS_DATAFLASH=$(SPI_BOOT) 
 endif
 
+ifeq ($(CONFIG_CHAIN_DATAFLASH),y)
+CPPFLAGS += -DAT91C_SPI_CLK=$(SPI_CLK)
+CPPFLAGS += -DAT91C_SPI_PCS_DATAFLASH=$(SPI_BOOT)
+endif
+
 # NAND flash support
 
 ifeq ($(CONFIG_NANDFLASH_SMALL_BLOCKS),y)
@@ -119,3 +233,7 @@ endif
 ifeq ($(CONFIG_DEBUG_VERY_LOUD),y)
 CPPFLAGS += -DBOOTSTRAP_DEBUG_LEVEL=DEBUG_VERY_LOUD
 endif
+
+ifeq ($(CONFIG_DBGU_ASYNC),y)
+CPPFLAGS += -DCONFIG_DBGU_ASYNC
+endif
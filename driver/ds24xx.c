@@ -29,8 +29,12 @@
 #include "pmc.h"
 #include "debug.h"
 #include "hardware.h"
+#include "board.h"
 #include "onewire_info.h"
 #include "string.h"
+#ifdef CONFIG_BOOT_TASKS
+#include "task.h"
+#endif
 
 #define ROM_COMMAND_READ		0x33
 #define ROM_COMMAND_MATCH		0x55
@@ -249,10 +253,23 @@ static int ds24xx_read_bit()
 	return status;
 }
 
+/*
+ * The bus may idle for any time between two slots, let the boot tasks
+ * run there.
+ */
+static void ds24xx_yield(void)
+{
+#ifdef CONFIG_BOOT_TASKS
+	task_yield();
+#endif
+}
+
 static void ds24xx_write_byte(unsigned char data)
 {
 	int i;
 
+	ds24xx_yield();
+
 	for (i = 0; i < 8; i++) {
 		ds24xx_write_bit(data & 1);
 		data >>= 1;
@@ -264,6 +281,8 @@ static unsigned char ds24xx_read_byte()
 	int i;
 	unsigned char result = 0;
 
+	ds24xx_yield();
+
 	for (i = 0; i < 8; i++) {
 		result >>= 1;
 		if (ds24xx_read_bit())
@@ -546,6 +565,98 @@ static int get_board_info(struct one_wire_info *p)
 	return 0;
 }
 
+#ifdef CONFIG_ONEWIRE_CACHE
+/*
+ * sn and rev stay in GPBR2/3 exactly as without the cache. A check word
+ * in the CONFIG_SYS_ONEWIRE_CACHE_GPBR of the board lets the next boot
+ * take them back instead of reading the chips again:
+ *
+ *   [31:24]  magic
+ *   [23:16]  CRC-8 of sn and rev
+ *   [15:8]   CRC byte of the first ROM ID found by the search
+ *   [7:0]    first serial number byte of that ROM ID
+ *
+ * The ROM bytes are 0 when no chip answers.
+ */
+#ifndef CONFIG_SYS_ONEWIRE_CACHE_GPBR
+#error "CONFIG_SYS_ONEWIRE_CACHE_GPBR must name a free GPBR of the board"
+#endif
+
+#if defined(CONFIG_SDCARD_FAST_INIT) \
+	&& ((CONFIG_SYS_ONEWIRE_CACHE_GPBR == CONFIG_SYS_MMC_CACHE_GPBR) \
+	|| (CONFIG_SYS_ONEWIRE_CACHE_GPBR == CONFIG_SYS_MMC_CACHE_GPBR + 1))
+#error "CONFIG_SYS_ONEWIRE_CACHE_GPBR is taken by the SD/MMC cache"
+#endif
+
+#define OW_CACHE_CHECK		(AT91C_BASE_GPBR + 4 * CONFIG_SYS_ONEWIRE_CACHE_GPBR)
+
+#define OW_CACHE_MAGIC		0xA5
+#define OW_CACHE_MAGIC_OFFSET	24
+#define OW_CACHE_CRC_OFFSET	16
+#define OW_CACHE_ROM_MASK	0xFFFF
+
+static unsigned char ow_cache_crc(unsigned int sn, unsigned int rev)
+{
+	int i;
+
+	crc8 = 0;
+	for (i = 0; i < 4; i++)
+		docrc8((sn >> (8 * i)) & 0xFF);
+	for (i = 0; i < 4; i++)
+		docrc8((rev >> (8 * i)) & 0xFF);
+
+	return crc8;
+}
+
+static unsigned int ow_cache_rom(const unsigned char *rom)
+{
+	return (rom[7] << 8) | rom[1];
+}
+
+static int ow_cache_load(void)
+{
+	unsigned int check = readl(OW_CACHE_CHECK);
+	unsigned int cached_sn = readl(AT91C_BASE_GPBR + 4 * 2);
+	unsigned int cached_rev = readl(AT91C_BASE_GPBR + 4 * 3);
+	int found;
+
+	if ((check >> OW_CACHE_MAGIC_OFFSET) != OW_CACHE_MAGIC)
+		return -1;
+
+	if (((check >> OW_CACHE_CRC_OFFSET) & 0xFF)
+		!= ow_cache_crc(cached_sn, cached_rev))
+		return -1;
+
+	/*
+	 * One search pass: the first chip found must be the same one,
+	 * or there must still be no chip at all.
+	 */
+	found = ds24xx_find_first();
+	if (found != (cached_sn != 0))
+		return -1;
+
+	if (found && (ow_cache_rom(buf) != (check & OW_CACHE_ROM_MASK)))
+		return -1;
+
+	sn = cached_sn;
+	rev = cached_rev;
+
+	return 0;
+}
+
+static void ow_cache_save(int cnt)
+{
+	unsigned int check;
+
+	check = (OW_CACHE_MAGIC << OW_CACHE_MAGIC_OFFSET)
+		| (ow_cache_crc(sn, rev) << OW_CACHE_CRC_OFFSET);
+	if (cnt)
+		check |= ow_cache_rom(device_id_array[0]);
+
+	writel(check, OW_CACHE_CHECK);
+}
+#endif /* #ifdef CONFIG_ONEWIRE_CACHE */
+
 void load_1wire_info()
 {
 	int i, cnt;
@@ -556,6 +667,14 @@ void load_1wire_info()
 	sn = rev = 0;
 
 	one_wire_hw_init();
+
+#ifdef CONFIG_ONEWIRE_CACHE
+	if (ow_cache_load() == 0) {
+		dbg_log(1, "sn: %x;   rev: %x (cached)\n\r", sn, rev);
+		return;
+	}
+#endif
+
 	cnt = enumerate_all_rom();
 
 	for (i = 0; i < cnt; i++) {
@@ -599,6 +718,10 @@ void load_1wire_info()
 	writel(sn, AT91C_BASE_GPBR + 4 * 2);
 	writel(rev, AT91C_BASE_GPBR + 4 * 3);
 
+#ifdef CONFIG_ONEWIRE_CACHE
+	ow_cache_save(cnt);
+#endif
+
 	return;
 err:
 	/* Hang: we can not continue */
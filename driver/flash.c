@@ -23,18 +23,253 @@
  * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
  * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
-#include "../include/part.h"
-#include "../include/main.h"
-#include "../include/flash.h"
-#include <stdlib.h>
+#include "common.h"
+#include "hardware.h"
+#include "board.h"
+#include "string.h"
+#include "flash.h"
+#include "image.h"
 
+#ifdef CONFIG_NORFLASH_DMA
+#include "dmac.h"
+#endif
 
-int load_norflash(unsigned int img_addr,
-		unsigned int img_size,
-		unsigned int img_dest)
+#include "debug.h"
+
+/* The SAMA5 SMC has no page mode */
+#if defined(CONFIG_NORFLASH_PAGE_MODE) && !defined(AT91SAMA5D3X)
+#include "arch/at91_smc.h"
+
+#define NOR_PAGE_MODE
+
+/* CFI query */
+#define CFI_QUERY_ADDR		0x55
+#define CFI_QUERY_CMD		0x98
+#define CFI_QRY			0x10
+#define CFI_PRI_CMDSET		0x13
+#define CFI_PRI_TABLE		0x15
+
+#define CFI_CMDSET_INTEL_EXT	0x0001
+#define CFI_CMDSET_AMD_STD	0x0002
+#define CFI_CMDSET_INTEL_STD	0x0003
+
+/* Offsets in the primary vendor extended table */
+#define CFI_AMD_PAGE_MODE	0x0c	/* 1: 4, 2: 8, 3: 16 words */
+#define CFI_INTEL_NR_PROT	0x0e	/* number of protection fields */
+#define CFI_INTEL_PAGE_MODE	0x13	/* log2(bytes), after the fields */
+
+#define CMD_AMD_RESET		0xf0
+#define CMD_INTEL_READ_ARRAY	0xff
+
+#define SMC_PAGE_SIZE_MAX	32
+#endif
+
+#ifdef NOR_PAGE_MODE
+static unsigned int nor_shift;	/* address shift for the bus width */
+
+static unsigned char cfi_read(unsigned int offset)
+{
+	return readb(AT91_NORFLASH_BASE + (offset << nor_shift));
+}
+
+static unsigned short cfi_read16(unsigned int offset)
+{
+	return cfi_read(offset) | (cfi_read(offset + 1) << 8);
+}
+
+/* Returns the page size in bytes, 0 if it is unknown */
+static unsigned int cfi_page_size(void)
+{
+	unsigned int cmdset, table, nr_prot;
+	unsigned int page = 0;
+
+	writew(CFI_QUERY_CMD, AT91_NORFLASH_BASE + (CFI_QUERY_ADDR << nor_shift));
+
+	if ((cfi_read(CFI_QRY) == 'Q') && (cfi_read(CFI_QRY + 1) == 'R')
+			&& (cfi_read(CFI_QRY + 2) == 'Y')) {
+		cmdset = cfi_read16(CFI_PRI_CMDSET);
+		table = cfi_read16(CFI_PRI_TABLE);
+
+		if (!table) {
+			page = 0;
+		} else if (cmdset == CFI_CMDSET_AMD_STD) {
+			page = cfi_read(table + CFI_AMD_PAGE_MODE);
+			page = page ? (4 << page) : 0;
+		} else if ((cmdset == CFI_CMDSET_INTEL_EXT)
+				|| (cmdset == CFI_CMDSET_INTEL_STD)) {
+			nr_prot = cfi_read(table + CFI_INTEL_NR_PROT);
+			if (nr_prot)
+				page = 1 << cfi_read(table + CFI_INTEL_PAGE_MODE
+							+ (nr_prot - 1) * 10);
+		}
+	} else {
+		dbg_log(1, "NOR: No CFI answer\n\r");
+	}
+
+	/* Back to read array mode, whatever the command set */
+	writew(CMD_AMD_RESET, AT91_NORFLASH_BASE);
+	writew(CMD_INTEL_READ_ARRAY, AT91_NORFLASH_BASE);
+
+	return page;
+}
+
+static void norflash_page_mode(void)
+{
+	unsigned int mode, pulse, page, ps;
+	unsigned int tpa;
+
+	mode = readl(AT91_NORFLASH_SMC + SMC_CTRL0);
+	nor_shift = ((mode & AT91C_SMC_DBW) == AT91C_SMC_DBW_WIDTH_BITS_16)
+			? 1 : 0;
+
+	page = cfi_page_size();
+	if (page < 4) {
+		dbg_log(1, "NOR: Page mode not supported\n\r");
+		return;
+	}
+
+	if (page > SMC_PAGE_SIZE_MAX)
+		page = SMC_PAGE_SIZE_MAX;
+
+	for (ps = 0; (4 << ps) < page; ps++)
+		;
+
+	/*
+	 * In page mode NCS_RD_PULSE covers the first access of a page and
+	 * NRD_PULSE the following ones, which only need tPA.
+	 */
+	tpa = (NORFLASH_TPA * (MASTER_CLOCK / 1000000) + 999) / 1000 + 1;
+	pulse = readl(AT91_NORFLASH_SMC + SMC_PULSE0);
+	if (tpa < ((pulse & AT91C_SMC_NRDPULSE) >> 16)) {
+		pulse &= ~AT91C_SMC_NRDPULSE;
+		pulse |= AT91C_SMC_NRDPULSE_(tpa);
+		writel(pulse, AT91_NORFLASH_SMC + SMC_PULSE0);
+	}
+
+	mode &= ~AT91C_SMC_PS;
+	mode |= AT91C_SMC_PMEN | (ps << 28);
+	writel(mode, AT91_NORFLASH_SMC + SMC_CTRL0);
+
+	dbg_log(1, "NOR: %d bytes page mode\n\r", 4 << ps);
+}
+#endif /* #ifdef NOR_PAGE_MODE */
+
+/* A whole SMC page per iteration, in as few bus cycles as possible */
+static void norflash_copy(void *dest, const void *src, unsigned int len)
+{
+	unsigned int *d = dest;
+	const unsigned int *s = src;
+
+#ifdef CONFIG_NORFLASH_DMA
+	if (dmac_memcpy(dest, src, len) == 0)
+		return;
+#endif
+
+	if (((unsigned int)dest | (unsigned int)src) & 3) {
+		memcpy(dest, src, len);
+		return;
+	}
+
+	for (; len >= 32; len -= 32) {
+		d[0] = s[0];
+		d[1] = s[1];
+		d[2] = s[2];
+		d[3] = s[3];
+		d[4] = s[4];
+		d[5] = s[5];
+		d[6] = s[6];
+		d[7] = s[7];
+		d += 8;
+		s += 8;
+	}
+
+	if (len)
+		memcpy(d, s, len);
+}
+
+#ifdef CONFIG_NORFLASH_XIP
+static unsigned int crc32(unsigned int crc, const unsigned char *p,
+			unsigned int len)
+{
+	unsigned int i;
+
+	crc = ~crc;
+	while (len--) {
+		crc ^= *p++;
+		for (i = 0; i < 8; i++)
+			crc = (crc >> 1) ^ ((crc & 1) ? 0xedb88320 : 0);
+	}
+
+	return ~crc;
+}
+
+/* Check the magic and the CRC of the legacy image header */
+static int norflash_check_header(const unsigned char *image)
+{
+	image_header_t header;
+	unsigned int hcrc;
+
+	memcpy(&header, image, sizeof(header));
+
+	if (ntohl(header.ih_magic) != IH_MAGIC) {
+		dbg_log(1, "NOR: Bad image magic: %d\n\r", ntohl(header.ih_magic));
+		return -1;
+	}
+
+	hcrc = ntohl(header.ih_hcrc);
+	header.ih_hcrc = 0;
+	if (crc32(0, (unsigned char *)&header, sizeof(header)) != hcrc) {
+		dbg_log(1, "NOR: Bad image header CRC\n\r");
+		return -1;
+	}
+
+	return 0;
+}
+
+/*
+ * Execute in place: nothing is copied, img_info->dest is pointed at the
+ * image in NOR. The kernel is only copied to its load address later if
+ * it was not linked to run from there.
+ */
+int norflash_xip_image(struct image_info *img_info)
+{
+	unsigned char *image = (unsigned char *)(AT91_NORFLASH_BASE
+							+ img_info->offset);
+
+	norflash_hw_init();
+
+#ifdef NOR_PAGE_MODE
+	norflash_page_mode();
+#endif
+
+	if (norflash_check_header(image))
+		return -1;
+
+	img_info->dest = image;
+
+	return 0;
+}
+#endif /* #ifdef CONFIG_NORFLASH_XIP */
+
+int load_norflash(struct image_info *img_info)
 {
-    norflash_hw_init();
+	norflash_hw_init();
+
+#ifdef CONFIG_NORFLASH_DMA
+	dmac_request(DMAC_CH_MEMCPY);
+#endif
+
+#ifdef NOR_PAGE_MODE
+	norflash_page_mode();
+#endif
+
+	dbg_log(1, "NOR: Copy %d bytes from %d to %d\n\r",
+		img_info->length, AT91_NORFLASH_BASE + img_info->offset,
+		img_info->dest);
+
+	norflash_copy(img_info->dest,
+			(void *)(AT91_NORFLASH_BASE + img_info->offset),
+			img_info->length);
 
-    memcpy((char *)img_dest, (char *)(AT91_NORFLASH_BASE + img_addr), img_size);
-    return 0;
+	return 0;
 }
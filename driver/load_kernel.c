@@ -27,12 +27,18 @@
  */
 #include "common.h"
 #include "hardware.h"
+#include "board.h"
 #include "arch/at91_pmc.h"
 #include "string.h"
+#include "dbgu.h"
 #include "slowclk.h"
 #include "dataflash.h"
 #include "nandflash.h"
 #include "sdcard.h"
+#include "flash.h"
+#include "image.h"
+#include "boot_media.h"
+#include "task.h"
 
 #include "debug.h"
 
@@ -105,28 +111,6 @@ struct tag {
 #define tag_next(t)	((struct tag *)((unsigned int *)(t) + (t)->hdr.size))
 #define tag_size(type)	((sizeof(struct tag_header) + sizeof(struct type)) >> 2)
 
-#define IH_MAGIC	0x27051956	/* Image Magic Number		*/
-#define IH_NMLEN	32		/* Image Name Length		*/
-
-/*
- * Legacy format image header,
- * all data in network byte order (aka natural aka bigendian).
- */
-typedef struct image_header {
-	unsigned int	ih_magic;	/* Image Header Magic Number	*/
-	unsigned int	ih_hcrc;	/* Image Header CRC Checksum	*/
-	unsigned int	ih_time;	/* Image Creation Timestamp	*/
-	unsigned int	ih_size;	/* Image Data Size		*/
-	unsigned int	ih_load;	/* Data	 Load  Address		*/
-	unsigned int	ih_ep;		/* Entry Point Address		*/
-	unsigned int	ih_dcrc;	/* Image Data CRC Checksum	*/
-	unsigned char	ih_os;		/* Operating System		*/
-	unsigned char	ih_arch;	/* CPU architecture		*/
-	unsigned char	ih_type;	/* Image Type			*/
-	unsigned char	ih_comp;	/* Compression Type		*/
-	unsigned char	ih_name[IH_NMLEN];	/* Image Name		*/
-} image_header_t;
-
 static struct tag *params = (struct tag *)(OS_MEM_BANK + 0x100);
 
 static void setup_start_tag (void)
@@ -233,13 +217,16 @@ int load_kernel(struct image_info *img_info)
 	image_header_t	*image_header;
 	unsigned int load_addr, image_size;
 	unsigned int magic_number;
-	unsigned int jump_addr = (unsigned int)img_info->dest;
+	unsigned int jump_addr;
 	unsigned int tags_addr = (unsigned int)(OS_MEM_BANK + 0x100);
 	int mach_type = MACH_TYPE;
 	int ret;
 
 	void (*kernel_entry)(int zero, int arch, unsigned int params);
 
+#if defined(CONFIG_BOOT_CHAIN)
+	ret = load_boot_media(img_info);
+#else
 #ifdef CONFIG_DATAFLASH
 	ret = load_dataflash(img_info);
 #endif
@@ -250,10 +237,22 @@ int load_kernel(struct image_info *img_info)
 
 #ifdef CONFIG_SDCARD
 	ret = load_sdcard(img_info);
+#endif
+
+#ifdef CONFIG_FLASH
+#ifdef CONFIG_NORFLASH_XIP
+	ret = norflash_xip_image(img_info);
+#else
+	ret = load_norflash(img_info);
+#endif
+#endif
 #endif
 	if (ret != 0)
 		return -1;
 
+	/* The image may be used in place, where the loader left it */
+	jump_addr = (unsigned int)img_info->dest;
+
 #ifdef CONFIG_SCLK
 	slowclk_switch_osc32();
 #endif
@@ -281,18 +280,38 @@ int load_kernel(struct image_info *img_info)
 #endif
 	kernel_entry = (void (*)(int, int, unsigned int))ntohl(image_header->ih_ep);
 
-	dbg_log(1, "Relocating kernel image, dest: %d, src: %d\n\r",
-		load_addr, jump_addr + sizeof(image_header_t));
+	if (load_addr != jump_addr + sizeof(image_header_t)) {
+		dbg_log(1, "Relocating kernel image, dest: %d, src: %d\n\r",
+			load_addr, jump_addr + sizeof(image_header_t));
 
-	memcpy((void *)load_addr, (void *)(jump_addr + sizeof(image_header_t)), image_size);
+		memcpy((void *)load_addr, (void *)(jump_addr + sizeof(image_header_t)), image_size);
 
-	dbg_log(1, "... %d bytes data transferred\n\r", image_size);
+		dbg_log(1, "... %d bytes data transferred\n\r", image_size);
+	} else {
+		/* e.g. an XIP_KERNEL build, it copies its own data to RAM */
+		dbg_log(1, "Kernel image in place at %d\n\r", load_addr);
+	}
 
 	setup_boot_tags();
 
+#ifdef CONFIG_BOOT_TASKS
+	task_wait_all();
+#endif
+
 	dbg_log(1, "\n\rStarting linux kernel ..., machid: %d, tags: %d\n\r\n\r",
 		mach_type, tags_addr);
 
+#ifdef CONFIG_CLOCK_BOOST
+	hw_clock_handoff();
+#endif
+
+#ifdef CONFIG_DEBUG_TRACE
+	dbg_trace_flush();
+#endif
+#ifdef CONFIG_DBGU_ASYNC
+	dbgu_flush();
+#endif
+
 	kernel_entry(0, mach_type, tags_addr);
 
 	return 0;
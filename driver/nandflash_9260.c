@@ -32,6 +32,7 @@
 #include "gpio.h"
 #include "debug.h"
 #include "nand.h"
+#include "pit_timer.h"
 #include "hamming.h"
 
 #define ECC_CORRECT_ERROR  0xfe
@@ -480,6 +481,41 @@ static int nandflash_recovery(void)
 }
 #endif /* #ifdef CONFIG_NANDFLASH_RECOVERY */
 
+#ifdef CONFIG_BOOT_CHAIN
+/*
+ * Check that a chip answers READ ID. The wait for the reset to complete
+ * gives up when the probe budget runs out.
+ */
+int nandflash_probe(void)
+{
+	unsigned char manf_id;
+
+	nandflash_hw_init();
+
+	nand_cs_enable();
+
+	nand_command(CMD_RESET);
+	nand_command(CMD_STATUS);
+	while (!(read_byte() & STATUS_READY)) {
+		if (pit_budget_expired()) {
+			nand_cs_disable();
+			return -1;
+		}
+	}
+
+	nand_command(CMD_READID);
+	nand_address(0x00);
+	manf_id = read_byte();
+
+	nand_cs_disable();
+
+	if ((manf_id == 0x00) || (manf_id == 0xff))
+		return -1;
+
+	return 0;
+}
+#endif /* #ifdef CONFIG_BOOT_CHAIN */
+
 int load_nandflash(struct image_info *img_info)
 {
 	struct nand_info nand;
@@ -30,11 +30,65 @@
 #include "board.h"
 
 #include "ff.h"
+#include "diskio.h"
+#include "media.h"
 
 #include "debug.h"
 
 #define CHUNK_SIZE	0x40000
 
+/* Room for (CLMT_SIZE - 2) / 2 fragments */
+#define CLMT_SIZE	64
+
+static DWORD clmt[CLMT_SIZE];
+
+/*
+ * Build the cluster link map of the file once, then read every
+ * contiguous fragment with a single disk_read(). The last sector is
+ * read whole, so up to one sector past the end of the file is written.
+ * Returns 1 if the map doesn't fit and the caller should use f_read().
+ */
+static int sdcard_read_extents(FIL *file, BYTE *dest)
+{
+	FATFS *fs = file->fs;
+	DWORD *tbl;
+	DWORD remain, count, sect;
+
+	file->cltbl = clmt;
+	clmt[0] = CLMT_SIZE;
+	if (f_lseek(file, CREATE_LINKMAP) != FR_OK) {
+		file->cltbl = 0;
+		return 1;
+	}
+
+	dbg_log(1, "SD/MMC: %d fragment(s)\n\r", (clmt[0] - 2) / 2);
+
+	remain = (file->fsize + _MAX_SS - 1) / _MAX_SS;
+	for (tbl = clmt + 1; remain && *tbl; tbl += 2) {
+		count = tbl[0] * fs->csize;
+		if (count > remain)
+			count = remain;
+
+		sect = (tbl[1] - 2) * fs->csize + fs->database;
+		if (disk_read(fs->drv, dest, sect, count) != RES_OK)
+			return -1;
+
+		dest += count * _MAX_SS;
+		remain -= count;
+	}
+
+	return remain ? -1 : 0;
+}
+
+#ifdef CONFIG_BOOT_CHAIN
+int sdcard_probe(void)
+{
+	at91_mci0_hw_init();
+
+	return mmc_probe();
+}
+#endif
+
 int load_sdcard(struct image_info *img_info)
 {
 	FATFS	fs;
@@ -45,6 +99,7 @@ int load_sdcard(struct image_info *img_info)
 	UINT byte_to_read = CHUNK_SIZE;
 	UINT byte_read;
 	char *filename = img_info->filename;
+	int ret;
 
 	at91_mci0_hw_init();
 
@@ -62,6 +117,15 @@ int load_sdcard(struct image_info *img_info)
 		return -1 ;
 	}
 
+	ret = sdcard_read_extents(&file, pdata);
+	if (ret < 0) {
+		dbg_log(1, "*** FATFS: read error\n\r");
+		return -1;
+	}
+
+	if (ret == 0)
+		goto out;
+
 	do {
 		byte_read = 0;
 		fret = f_read(&file, (void *)(pdata), byte_to_read, &byte_read);
@@ -73,6 +137,15 @@ int load_sdcard(struct image_info *img_info)
 		 return -1;
 	}
 
+out:
+#ifdef CONFIG_DEBUG
+	{
+		unsigned int reads, sectors;
+
+		disk_get_stats(&reads, &sectors);
+		dbg_log(1, "SD/MMC: %d reads, %d sectors\n\r", reads, sectors);
+	}
+#endif
 	fret = f_close(&file);
 
 	return 0;
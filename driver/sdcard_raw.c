@@ -0,0 +1,307 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "common.h"
+#include "hardware.h"
+#include "board.h"
+#include "string.h"
+#include "media.h"
+#include "image.h"
+#ifdef CONFIG_SDCARD_EXT4
+#include "ext4.h"
+#endif
+
+#include "debug.h"
+
+#define SECTOR_SIZE		512
+
+/* MBR layout */
+#define MBR_PART_TABLE		446
+#define MBR_PART_ENTRY_SIZE	16
+#define MBR_NR_PARTS		4
+#define MBR_SIGNATURE		0xaa55
+#define MBR_TYPE_GPT		0xee
+
+/* GPT layout */
+#define GPT_HEADER_LBA		1
+#define GPT_SIGNATURE_LO	0x20494645	/* "EFI " */
+#define GPT_SIGNATURE_HI	0x54524150	/* "PART" */
+#define GPT_ENTRY_SIZE_MIN	128
+
+#define get_le16(p)	((p)[0] | ((p)[1] << 8))
+#define get_le32(p)	((p)[0] | ((p)[1] << 8) | ((p)[2] << 16) \
+				| ((unsigned int)(p)[3] << 24))
+#define get_be32(p)	(((unsigned int)(p)[0] << 24) | ((p)[1] << 16) \
+				| ((p)[2] << 8) | (p)[3])
+
+#ifdef CONFIG_SDCARD_PART
+static unsigned int sector_buf[SECTOR_SIZE / 4];
+
+static int hex_digit(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+
+	return -1;
+}
+
+/*
+ * Convert "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx" to its on-disk form:
+ * the first three fields are stored little endian.
+ */
+static int guid_parse(const char *str, unsigned char *guid)
+{
+	static const unsigned char order[16] = {
+		3, 2, 1, 0, 5, 4, 7, 6, 8, 9, 10, 11, 12, 13, 14, 15
+	};
+	unsigned int i;
+	int hi, lo;
+
+	for (i = 0; i < 16; i++) {
+		if (*str == '-')
+			str++;
+		hi = hex_digit(*str++);
+		if (hi < 0)
+			return -1;
+		lo = hex_digit(*str++);
+		if (lo < 0)
+			return -1;
+		guid[order[i]] = (hi << 4) | lo;
+	}
+
+	return 0;
+}
+
+static int gpt_find_partition(unsigned int *start, unsigned int *nr_sectors)
+{
+	unsigned char *buf = (unsigned char *)sector_buf;
+	unsigned char type[16];
+	unsigned int entry_lba, nr_entries, entry_size;
+	unsigned int index, lba = 0;
+	unsigned char *entry;
+	int by_type = (SDCARD_PART_TYPE[0] != '\0');
+
+	if (by_type && guid_parse(SDCARD_PART_TYPE, type)) {
+		dbg_log(1, "SD/MMC: Bad partition type GUID\n\r");
+		return -1;
+	}
+
+	if (mmc_bread(GPT_HEADER_LBA, 1, buf) != 1)
+		return -1;
+
+	if ((get_le32(buf) != GPT_SIGNATURE_LO)
+			|| (get_le32(buf + 4) != GPT_SIGNATURE_HI))
+		return -1;
+
+	entry_lba = get_le32(buf + 72);
+	nr_entries = get_le32(buf + 80);
+	entry_size = get_le32(buf + 84);
+	if ((entry_size < GPT_ENTRY_SIZE_MIN) || (SECTOR_SIZE % entry_size))
+		return -1;
+
+	for (index = 0; index < nr_entries; index++) {
+		if ((index * entry_size) % SECTOR_SIZE == 0) {
+			lba = entry_lba + (index * entry_size) / SECTOR_SIZE;
+			if (mmc_bread(lba, 1, buf) != 1)
+				return -1;
+		}
+		entry = buf + (index * entry_size) % SECTOR_SIZE;
+
+		if (by_type) {
+			if (memcmp(entry, type, 16))
+				continue;
+		} else if (index + 1 != SDCARD_PART_NUM)
+			continue;
+
+		/* Only the low 32 bits of the LBAs are used */
+		*start = get_le32(entry + 32);
+		*nr_sectors = get_le32(entry + 40) - *start + 1;
+		return 0;
+	}
+
+	return -1;
+}
+
+static int find_partition(unsigned int *start, unsigned int *nr_sectors)
+{
+	unsigned char *buf = (unsigned char *)sector_buf;
+	unsigned char *entry;
+
+	if (mmc_bread(0, 1, buf) != 1)
+		return -1;
+
+	if (get_le16(buf + 510) != MBR_SIGNATURE) {
+		dbg_log(1, "SD/MMC: No MBR found\n\r");
+		return -1;
+	}
+
+	entry = buf + MBR_PART_TABLE;
+	if (entry[4] == MBR_TYPE_GPT)
+		return gpt_find_partition(start, nr_sectors);
+
+	if ((SDCARD_PART_TYPE[0] != '\0')
+		|| (SDCARD_PART_NUM < 1) || (SDCARD_PART_NUM > MBR_NR_PARTS)) {
+		dbg_log(1, "SD/MMC: Partition not supported on a MBR disk\n\r");
+		return -1;
+	}
+
+	entry += (SDCARD_PART_NUM - 1) * MBR_PART_ENTRY_SIZE;
+	*start = get_le32(entry + 8);
+	*nr_sectors = get_le32(entry + 12);
+
+	return (*nr_sectors == 0) ? -1 : 0;
+}
+#endif /* #ifdef CONFIG_SDCARD_PART */
+
+#ifdef CONFIG_BOOT_CHAIN
+int sdcard_probe(void)
+{
+	at91_mci0_hw_init();
+
+	return mmc_probe();
+}
+#endif
+
+#ifdef CONFIG_SDCARD_EXT4
+/* Reads the image file from the ext2/3/4 partition starting at start */
+static int sdcard_load_ext4(struct image_info *img_info, unsigned int start)
+{
+	unsigned int length = img_info->length;
+
+	dbg_log(1, "SD/MMC: Reading %s from LBA %d to %d\n\r",
+			img_info->filename, start, img_info->dest);
+
+	if (ext4_mount(start)) {
+		dbg_log(1, "SD/MMC: No ext2/3/4 file system found\n\r");
+		return -1;
+	}
+
+	if (ext4_load(img_info->filename, img_info->dest, &length)) {
+		dbg_log(1, "SD/MMC: Failed to read %s\n\r", img_info->filename);
+		return -1;
+	}
+
+	return 0;
+}
+#else
+/* Reads the image from the selected area of the card */
+static int sdcard_read_image(struct image_info *img_info,
+				unsigned int start, unsigned int nr_sectors)
+{
+	unsigned char *dest = img_info->dest;
+	unsigned int length = img_info->length;
+	unsigned int count;
+
+	count = (length + SECTOR_SIZE - 1) / SECTOR_SIZE;
+	if (count > nr_sectors)
+		count = nr_sectors;
+	if (count == 0)
+		return -1;
+
+	dbg_log(1, "SD/MMC: Copy %d sectors from LBA %d to %d\n\r",
+			count, start, dest);
+
+	/* Read the first sector to see how long the image really is */
+	if (mmc_bread(start, 1, dest) != 1)
+		return -1;
+
+	if (get_be32(dest) == IH_MAGIC) {
+		length = get_be32(dest + 12) + sizeof(image_header_t);
+		length = (length + SECTOR_SIZE - 1) / SECTOR_SIZE;
+		if (length < count)
+			count = length;
+	}
+
+	if (count > 1) {
+		if (mmc_bread(start + 1, count - 1, dest + SECTOR_SIZE)
+				!= count - 1) {
+			dbg_log(1, "SD/MMC: Read error\n\r");
+			return -1;
+		}
+	}
+
+	return 0;
+}
+#endif /* #ifdef CONFIG_SDCARD_EXT4 */
+
+int load_sdcard(struct image_info *img_info)
+{
+	unsigned int start, nr_sectors;
+	int ret;
+
+	at91_mci0_hw_init();
+
+	if (mmc_initialize()) {
+		dbg_log(1, "SD/MMC: Failed to initialize card\n\r");
+		return -1;
+	}
+
+#ifdef CONFIG_SDCARD_PART
+	if (find_partition(&start, &nr_sectors)) {
+		dbg_log(1, "SD/MMC: Boot partition not found\n\r");
+		return -1;
+	}
+#else
+	start = img_info->offset / SECTOR_SIZE;
+	nr_sectors = ~0U;
+#ifdef CONFIG_SDCARD_EMMC_BOOT
+	if (mmc_switch_part(EMMC_BOOT_PART, &nr_sectors)) {
+		dbg_log(1, "SD/MMC: Failed to select boot partition %d\n\r",
+				EMMC_BOOT_PART);
+		return -1;
+	}
+
+	if (start >= nr_sectors)
+		ret = -1;
+	else
+		ret = sdcard_read_image(img_info, start, nr_sectors - start);
+
+	/*
+	 * U-Boot and the kernel address the user area with the same LBAs,
+	 * give it back to them whatever happened.
+	 */
+	if (mmc_switch_part(0, NULL)) {
+		dbg_log(1, "SD/MMC: Failed to select the user area\n\r");
+		ret = -1;
+	}
+
+	return ret;
+#endif
+#endif
+
+#ifdef CONFIG_SDCARD_EXT4
+	ret = sdcard_load_ext4(img_info, start);
+#else
+	ret = sdcard_read_image(img_info, start, nr_sectors);
+#endif
+
+	return ret;
+}
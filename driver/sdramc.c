@@ -29,6 +29,8 @@
 #include "board.h"
 #include "arch/at91_sdramc.h"
 #include "sdramc.h"
+#include "dram_timing.h"
+#include "debug.h"
 
 static inline void sdramc_writel(unsigned int reg, const unsigned int value)
 {
@@ -88,3 +90,47 @@ int sdramc_initialize(struct sdramc_register *sdramc_config,
 
 	return 0;
 }
+
+void sdramc_set_refresh(unsigned int tr)
+{
+	sdramc_writel(SDRAMC_TR, tr);
+}
+
+/*
+ * Fill TR and the timing fields of CR with the tightest values the memory
+ * allows at the given MCK. The geometry bits already in CR are kept.
+ */
+int sdramc_timing(struct sdramc_register *sdramc_config,
+			const struct dram_timing *timing,
+			unsigned int mck)
+{
+	int saturated = 0;
+
+	sdramc_config->tr = dram_field(DRAM_REFRESH_COUNT(timing->trefi, mck),
+					AT91C_SDRAMC_COUNT, &saturated);
+
+	sdramc_config->cr &= ~(AT91C_SDRAMC_TWR | AT91C_SDRAMC_TRC
+				| AT91C_SDRAMC_TRP | AT91C_SDRAMC_TRCD
+				| AT91C_SDRAMC_TRAS | AT91C_SDRAMC_TXS);
+
+	sdramc_config->cr
+		|= dram_field(DRAM_NS_TO_CYCLES(timing->twr, mck),
+				AT91C_SDRAMC_TWR, &saturated)
+		| dram_field(DRAM_NS_TO_CYCLES(timing->trc, mck),
+				AT91C_SDRAMC_TRC, &saturated)
+		| dram_field(DRAM_NS_TO_CYCLES(timing->trp, mck),
+				AT91C_SDRAMC_TRP, &saturated)
+		| dram_field(DRAM_NS_TO_CYCLES(timing->trcd, mck),
+				AT91C_SDRAMC_TRCD, &saturated)
+		| dram_field(DRAM_NS_TO_CYCLES(timing->tras, mck),
+				AT91C_SDRAMC_TRAS, &saturated)
+		| dram_field(DRAM_NS_TO_CYCLES(timing->txsnr, mck),
+				AT91C_SDRAMC_TXS, &saturated);
+
+	if (saturated) {
+		dbg_log(1, "SDRAM: timings out of range at %d Hz\n\r", mck);
+		return -1;
+	}
+
+	return 0;
+}
@@ -32,6 +32,7 @@
 #include "arch/at91_pio.h"
 #include "gpio.h"
 #include "string.h"
+#include "pit_timer.h"
 
 #include "debug.h"
 
@@ -44,6 +45,12 @@
 #define CMD_READ_ARRAY_FAST		0x0b
 #define CMD_READ_ARRAY_LEGACY		0xe8
 
+/* JEDEC SPI NOR commands */
+#define CMD_READ_SFDP			0x5a
+#define CMD_READ_ARRAY_FAST_4B		0x0c
+#define CMD_ENTER_4B_ADDR		0xb7
+#define CMD_EXIT_4B_ADDR		0xe9
+
 /* AT45-specific commands */
 #define CMD_AT45_READ_STATUS		0xd7
 
@@ -637,6 +644,304 @@ static int dataflash_erase_at25(unsigned int offset, unsigned int len)
 #define IDCODE_LEN	5
 #define MANU_ID_ATMEL	0x1F
 
+#ifdef CONFIG_DATAFLASH_JEDEC
+#define MANU_ID_SPANSION	0x01
+#define MANU_ID_MICRON		0x20
+#define MANU_ID_MACRONIX	0xC2
+#define MANU_ID_WINBOND		0xEF
+
+/* Parts known without SFDP, idcode[0..2] and log2 of the size */
+struct jedec_flash_params {
+	unsigned char	manu_id;
+	unsigned char	idcode1;
+	unsigned char	idcode2;
+	unsigned char	l2_size;
+	const char	*name;
+};
+
+static const struct jedec_flash_params jedec_flash_table[] = {
+	{MANU_ID_WINBOND,	0x40, 0x16, 22, "W25Q32"},
+	{MANU_ID_WINBOND,	0x40, 0x17, 23, "W25Q64"},
+	{MANU_ID_WINBOND,	0x40, 0x18, 24, "W25Q128"},
+	{MANU_ID_WINBOND,	0x40, 0x19, 25, "W25Q256"},
+	{MANU_ID_MACRONIX,	0x20, 0x16, 22, "MX25L3205"},
+	{MANU_ID_MACRONIX,	0x20, 0x17, 23, "MX25L6405"},
+	{MANU_ID_MACRONIX,	0x20, 0x18, 24, "MX25L12805"},
+	{MANU_ID_MACRONIX,	0x20, 0x19, 25, "MX25L25635"},
+	{MANU_ID_MICRON,	0xBA, 0x16, 22, "N25Q032"},
+	{MANU_ID_MICRON,	0xBA, 0x17, 23, "N25Q064"},
+	{MANU_ID_MICRON,	0xBA, 0x18, 24, "N25Q128"},
+	{MANU_ID_MICRON,	0xBA, 0x19, 25, "N25Q256"},
+	{MANU_ID_SPANSION,	0x20, 0x18, 24, "S25FL128S"},
+	{MANU_ID_SPANSION,	0x02, 0x19, 25, "S25FL256S"},
+};
+
+/* How the array is read, chosen at probe time */
+struct sf_read_op {
+	unsigned char	opcode;
+	unsigned char	addr_len;	/* 3 or 4 address bytes */
+	unsigned char	dummy_len;	/* dummy bytes after the address */
+	unsigned char	enter_4b;	/* switch to 4-byte mode around reads */
+};
+
+static struct sf_read_op sf_read_op;
+
+/* SFDP (JESD216) layout */
+#define SFDP_SIGNATURE		0x50444653	/* "SFDP" */
+#define SFDP_MAX_HEADERS	8
+#define SFDP_BFPT_ID		0xff00		/* Basic Flash Parameter Table */
+#define SFDP_4BAIT_ID		0xff84		/* 4-byte Address Instruction */
+#define SFDP_BFPT_DWORDS	16
+
+#define BFPT_DW1_ADDR_BYTES(x)		(((x) >> 17) & 0x3)
+#define 	BFPT_ADDR_3B		0x0
+#define 	BFPT_ADDR_3B_OR_4B	0x1
+#define 	BFPT_ADDR_4B		0x2
+#define BFPT_DW11_PAGE_SIZE(x)		(((x) >> 4) & 0xf)
+#define SFDP_4BAIT_READ_FAST_4B		(1 << 1)
+
+#define sfdp_le32(p)	((p)[0] | ((p)[1] << 8) | ((p)[2] << 16) \
+				| ((unsigned int)(p)[3] << 24))
+
+static int sf_write_cmd(unsigned char opcode)
+{
+	at25_write_enable(1);
+
+	return sf_cmd_write(&opcode, 1, NULL, 0);
+}
+
+static int sf_cmd_read_jedec(unsigned int offset, unsigned int len, void *buf)
+{
+	unsigned char cmd[6];
+	unsigned int cmd_len = 0;
+	int ret;
+
+	if (sf_read_op.enter_4b) {
+		ret = sf_write_cmd(CMD_ENTER_4B_ADDR);
+		if (ret)
+			return ret;
+	}
+
+	cmd[cmd_len++] = sf_read_op.opcode;
+	if (sf_read_op.addr_len == 4)
+		cmd[cmd_len++] = offset >> 24;
+	cmd[cmd_len++] = offset >> 16;
+	cmd[cmd_len++] = offset >> 8;
+	cmd[cmd_len++] = offset >> 0;
+	if (sf_read_op.dummy_len)
+		cmd[cmd_len++] = 0x00;
+
+	ret = sf_cmd_read(cmd, cmd_len, buf, len);
+
+	/* Leave the part in 3-byte mode for the ROM code and the next stage */
+	if (sf_read_op.enter_4b)
+		sf_write_cmd(CMD_EXIT_4B_ADDR);
+
+	return ret;
+}
+
+static int sfdp_read(unsigned int addr, void *buf, unsigned int len)
+{
+	unsigned char cmd[5];
+
+	cmd[0] = CMD_READ_SFDP;
+	cmd[1] = addr >> 16;
+	cmd[2] = addr >> 8;
+	cmd[3] = addr >> 0;
+	cmd[4] = 0x00;
+
+	return sf_read_write(cmd, sizeof(cmd), NULL, buf, len);
+}
+
+/*
+ * Parse the SFDP tables. Returns log2 of the size in bytes, or -1
+ * if the part has no usable SFDP.
+ */
+static int sfdp_parse(unsigned int *page_size, unsigned char *addr_mode,
+			unsigned char *has_read_4b)
+{
+	unsigned char header[8 * (SFDP_MAX_HEADERS + 1)];
+	unsigned char bfpt[4 * SFDP_BFPT_DWORDS];
+	unsigned char *ph;
+	unsigned int bfpt_addr = 0, bfpt_len = 0;
+	unsigned int nph, id, i;
+	unsigned int dword, l2_size;
+
+	if (sfdp_read(0, header, 8))
+		return -1;
+
+	if (sfdp_le32(header) != SFDP_SIGNATURE)
+		return -1;
+
+	nph = header[6] + 1;
+	if (nph > SFDP_MAX_HEADERS)
+		nph = SFDP_MAX_HEADERS;
+
+	if (sfdp_read(8, header + 8, 8 * nph))
+		return -1;
+
+	*has_read_4b = 0;
+	for (i = 0; i < nph; i++) {
+		ph = header + 8 * (i + 1);
+		id = (ph[7] << 8) | ph[0];
+
+		if (id == SFDP_BFPT_ID && !bfpt_len) {
+			bfpt_len = ph[3];
+			bfpt_addr = ph[4] | (ph[5] << 8) | (ph[6] << 16);
+		} else if (id == SFDP_4BAIT_ID) {
+			if (sfdp_read(ph[4] | (ph[5] << 8) | (ph[6] << 16),
+					bfpt, 4))
+				return -1;
+			if (sfdp_le32(bfpt) & SFDP_4BAIT_READ_FAST_4B)
+				*has_read_4b = 1;
+		}
+	}
+
+	if (bfpt_len < 9)
+		return -1;
+	if (bfpt_len > SFDP_BFPT_DWORDS)
+		bfpt_len = SFDP_BFPT_DWORDS;
+
+	if (sfdp_read(bfpt_addr, bfpt, 4 * bfpt_len))
+		return -1;
+
+	*addr_mode = BFPT_DW1_ADDR_BYTES(sfdp_le32(bfpt));
+
+	/* Density, in bits */
+	dword = sfdp_le32(bfpt + 4);
+	if (dword & 0x80000000)
+		l2_size = (dword & 0x7fffffff) - 3;
+	else
+		for (l2_size = 0; (1U << l2_size) < (dword >> 3) + 1; l2_size++)
+			;
+
+	*page_size = 256;
+	if (bfpt_len >= 11)
+		*page_size = 1 << BFPT_DW11_PAGE_SIZE(sfdp_le32(bfpt + 40));
+
+	return l2_size;
+}
+
+static int jedec_sf_probe(const unsigned char *idcode)
+{
+	const struct jedec_flash_params *params;
+	unsigned int page_size = 256;
+	unsigned char addr_mode = BFPT_ADDR_3B;
+	unsigned char has_read_4b = 0;
+	unsigned int i;
+	int l2_size;
+
+	atmel_sf_params.name = "SFDP SPI NOR";
+
+	l2_size = sfdp_parse(&page_size, &addr_mode, &has_read_4b);
+	if (l2_size < 0) {
+		for (i = 0; i < ARRAY_SIZE(jedec_flash_table); i++) {
+			params = &jedec_flash_table[i];
+			if ((params->manu_id == idcode[0])
+				&& (params->idcode1 == idcode[1])
+				&& (params->idcode2 == idcode[2]))
+				break;
+		}
+
+		if (i == ARRAY_SIZE(jedec_flash_table)) {
+			dbg_log(1, "SF: Unsupported SerialFlash ID %d %d %d\n\r",
+					idcode[0], idcode[1], idcode[2]);
+			return -1;
+		}
+
+		atmel_sf_params.name = params->name;
+		l2_size = params->l2_size;
+		if (l2_size > 24) {
+			addr_mode = BFPT_ADDR_3B_OR_4B;
+			has_read_4b = 1;
+		}
+	}
+
+	/* Single lane fast read, one dummy byte */
+	sf_read_op.opcode = CMD_READ_ARRAY_FAST;
+	sf_read_op.addr_len = 3;
+	sf_read_op.dummy_len = 1;
+	sf_read_op.enter_4b = 0;
+
+	if (addr_mode == BFPT_ADDR_4B) {
+		sf_read_op.addr_len = 4;
+	} else if (l2_size > 24) {
+		sf_read_op.addr_len = 4;
+		if (has_read_4b)
+			sf_read_op.opcode = CMD_READ_ARRAY_FAST_4B;
+		else
+			sf_read_op.enter_4b = 1;
+	}
+
+	dbg_log(1, "SF: size: 2^%d bytes, page: %d bytes, read cmd: %d/%d\n\r",
+			l2_size, page_size,
+			sf_read_op.opcode, sf_read_op.addr_len);
+
+	sf_read = sf_cmd_read_jedec;
+	sf_erase = dataflash_erase_at25;
+
+	return 0;
+}
+#endif /* #ifdef CONFIG_DATAFLASH_JEDEC */
+
+
+#ifdef CONFIG_DATAFLASH_AUTOTUNE
+/* Bytes compared at each step, the start of the bootstrap itself */
+#define SF_TUNE_LEN	64
+
+static int sf_tune_read(unsigned char *buf)
+{
+	return (*sf_read)(0, SF_TUNE_LEN, buf);
+}
+
+/*
+ * Raise the SPI clock one SCBR step at a time, as long as the
+ * signature read back twice matches the one read at the safe clock.
+ * DLYBS/DLYBCT stay at zero: chip select is driven by a GPIO, so
+ * they would only add delay.
+ */
+static unsigned int sf_autotune(unsigned int clock, unsigned int spi_mode)
+{
+	unsigned char ref[SF_TUNE_LEN];
+	unsigned char buf[SF_TUNE_LEN];
+	unsigned int scbr, min_scbr, best_scbr;
+	unsigned int i;
+
+	if (sf_tune_read(ref))
+		return clock;
+
+	/* A blank area can not tell a good read from a bad one */
+	for (i = 1; i < SF_TUNE_LEN; i++)
+		if (ref[i] != ref[0])
+			break;
+	if (i == SF_TUNE_LEN) {
+		dbg_log(1, "SF: No signature to tune the SPI clock on\n\r");
+		return clock;
+	}
+
+	best_scbr = MASTER_CLOCK / clock;
+	min_scbr = (MASTER_CLOCK + AT91C_SPI_MAX_CLK - 1) / AT91C_SPI_MAX_CLK;
+	if (min_scbr == 0)
+		min_scbr = 1;
+
+	for (scbr = best_scbr - 1; scbr >= min_scbr; scbr--) {
+		at91_spi_init(MASTER_CLOCK / scbr, spi_mode);
+
+		if (sf_tune_read(buf) || memcmp(buf, ref, SF_TUNE_LEN))
+			break;
+		if (sf_tune_read(buf) || memcmp(buf, ref, SF_TUNE_LEN))
+			break;
+
+		best_scbr = scbr;
+	}
+
+	clock = MASTER_CLOCK / best_scbr;
+	at91_spi_init(clock, spi_mode);
+
+	return clock;
+}
+#endif /* #ifdef CONFIG_DATAFLASH_AUTOTUNE */
+
 static int atmel_sf_probe(unsigned int clock, unsigned int spi_mode)
 {
 	const struct serial_flash_params *sf_params = &atmel_sf_params;
@@ -714,12 +1019,23 @@ static int atmel_sf_probe(unsigned int clock, unsigned int spi_mode)
 		}
 
 	} else {
+#ifdef CONFIG_DATAFLASH_JEDEC
+		ret = jedec_sf_probe(idcode);
+		if (ret)
+			goto err;
+#else
 		dbg_log(1, "SF: Unsupported SerialFlash Manufacturer ID %d\n\r", manu_id);
 		goto err;
+#endif
 	}
 
 	dbg_log(1, "SF: Detected flash %s\n\r", sf_params->name);
 
+#ifdef CONFIG_DATAFLASH_AUTOTUNE
+	clock = sf_autotune(clock, spi_mode);
+	dbg_log(1, "SF: SPI clock: %d Hz\n\r", clock);
+#endif
+
 	at91_spi_disable();
 
 	return 0;
@@ -765,6 +1081,36 @@ static int dataflash_recovery(void)
 }
 #endif /* #ifdef CONFIG_DATAFLASH_RECOVERY */
 
+#ifdef CONFIG_BOOT_CHAIN
+/*
+ * Check that a serial flash answers READ ID, with an empty socket
+ * MISO reads as all zeros or all ones. A part still in its power-up
+ * delay reads the same way, so retry until the probe budget runs out.
+ */
+int dataflash_probe(void)
+{
+	unsigned char idcode[IDCODE_LEN];
+
+	at91_spi0_hw_init();
+
+	if (at91_spi_init(CONFIG_SYS_SPI_CLOCK, CONFIG_SYS_SPI_MODE))
+		return -1;
+
+	if (at91_spi_enable())
+		return -1;
+
+	do {
+		if (sf_cmd_read_id(idcode, sizeof(idcode)))
+			return -1;
+
+		if ((idcode[0] != 0x00) && (idcode[0] != 0xff))
+			return 0;
+	} while (!pit_budget_expired());
+
+	return -1;
+}
+#endif /* #ifdef CONFIG_BOOT_CHAIN */
+
 int load_dataflash(struct image_info *img_info)
 {
 	unsigned int offset = img_info->offset;
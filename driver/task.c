@@ -0,0 +1,96 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "common.h"
+#include "hardware.h"
+#include "pit_timer.h"
+#include "task.h"
+
+static struct task *task_list;
+static int task_running;
+
+void task_start(struct task *task)
+{
+	if (task->active)
+		return;
+
+	task->state = 0;
+	task->result = 0;
+	task->active = 1;
+	task->wake = pit_get_ticks();
+
+	task->next = task_list;
+	task_list = task;
+}
+
+/* time unit: us */
+void task_sleep(struct task *task, unsigned int time)
+{
+	task->wake = pit_get_ticks() + pit_us_to_ticks(time);
+}
+
+/*
+ * Give every task which is due one step. Busy waits which can be cut
+ * in pieces call it, so the tasks progress meanwhile.
+ */
+void task_yield(void)
+{
+	struct task **link = &task_list;
+	struct task *task;
+
+	/* a task waiting for a device does not run the others */
+	if (task_running)
+		return;
+
+	task_running = 1;
+
+	while ((task = *link) != NULL) {
+		if (pit_ticks_passed(task->wake)
+				&& (task->run(task) == TASK_DONE)) {
+			task->active = 0;
+			*link = task->next;
+			continue;
+		}
+		link = &task->next;
+	}
+
+	task_running = 0;
+}
+
+int task_wait(struct task *task)
+{
+	while (task->active)
+		task_yield();
+
+	return task->result;
+}
+
+void task_wait_all(void)
+{
+	while (task_list)
+		task_yield();
+}
@@ -29,7 +29,7 @@ typedef enum {
 int assign_drives (int, int);
 DSTATUS disk_initialize (BYTE);
 DSTATUS disk_status (BYTE);
-DRESULT disk_read (BYTE, BYTE*, DWORD, BYTE);
+DRESULT disk_read (BYTE, BYTE*, DWORD, UINT);
 #if	_READONLY == 0
 DRESULT disk_write (BYTE, const BYTE*, DWORD, BYTE);
 #endif
@@ -38,6 +38,10 @@ DRESULT disk_write (BYTE, const BYTE*, DWORD, BYTE);
 DRESULT disk_ioctl (BYTE, BYTE, void*);
 #endif
 
+#ifdef CONFIG_DEBUG
+void disk_get_stats (unsigned int*, unsigned int*);
+#endif
+
 
 /* Disk Status Bits (DSTATUS) */
 
@@ -29,6 +29,9 @@
 #define __MEDIA_H__
 
 extern int mmc_initialize(void);
+extern int mmc_probe(void);
+extern void mmc_power_up_start(void);
+extern int mmc_switch_part(unsigned int part, unsigned int *nr_blocks);
 extern unsigned int mmc_bread(unsigned int start, unsigned int blkcnt, void *dest);
 
 #endif
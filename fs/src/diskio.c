@@ -8,12 +8,55 @@
 #include "ffconf.h"
 #include "integer.h"
 #include "media.h"
+#include "string.h"
 
 //------------------------------------------------------------------------------
 //         Internal variables
 
 static volatile DSTATUS Stat = STA_NOINIT;	/* Disk status */
 
+#ifdef CONFIG_SDCARD_CACHE
+/* Read-ahead cache for the single sector (FAT, directory) reads */
+#define SECTOR_SIZE	512
+#define LINE_SIZE	(SDCARD_CACHE_RA * SECTOR_SIZE)
+
+struct cache_line {
+	DWORD sector;		/* First sector held */
+	UINT count;		/* Valid sectors, 0 if empty */
+	UINT stamp;		/* Last use, for LRU replacement */
+	BYTE *data;
+};
+
+static struct cache_line cache[SDCARD_CACHE_LINES];
+static UINT cache_clock;
+
+#ifndef SDCARD_CACHE_ADDR
+static unsigned int cache_buf[SDCARD_CACHE_LINES * LINE_SIZE / 4];
+#define SDCARD_CACHE_ADDR	cache_buf
+#endif
+#endif
+
+#ifdef CONFIG_DEBUG
+/* Commands and sectors sent to the card, to profile the loader */
+static unsigned int stat_reads;
+static unsigned int stat_sectors;
+
+void disk_get_stats(unsigned int *reads, unsigned int *sectors)
+{
+	*reads = stat_reads;
+	*sectors = stat_sectors;
+}
+#endif
+
+static unsigned int disk_bread(DWORD sector, UINT count, void *buff)
+{
+#ifdef CONFIG_DEBUG
+	stat_reads++;
+	stat_sectors += count;
+#endif
+	return mmc_bread((unsigned int)sector, count, buff);
+}
+
 //------------------------------------------------------------------------------
 /* Initialize a Drive                                                    */
 /*-----------------------------------------------------------------------*/
@@ -26,9 +69,60 @@ DSTATUS disk_initialize(BYTE drv        /* Physical drive number (0..) */
 	if (mmc_initialize() == 0)
 		Stat &= ~STA_NOINIT;
 
+#ifdef CONFIG_SDCARD_CACHE
+	{
+		int i;
+
+		for (i = 0; i < SDCARD_CACHE_LINES; i++) {
+			cache[i].count = 0;
+			cache[i].data = (BYTE *)SDCARD_CACHE_ADDR
+						+ i * LINE_SIZE;
+		}
+	}
+#endif
+
 	return Stat;
 }
 
+#ifdef CONFIG_SDCARD_CACHE
+static DRESULT cache_read(BYTE *buff, DWORD sector)
+{
+	struct cache_line *line, *victim = cache;
+	int i;
+
+	for (i = 0, line = cache; i < SDCARD_CACHE_LINES; i++, line++) {
+		if (line->count && (sector - line->sector) < line->count) {
+			line->stamp = ++cache_clock;
+			memcpy(buff, line->data
+				+ (sector - line->sector) * SECTOR_SIZE,
+				SECTOR_SIZE);
+			return RES_OK;
+		}
+
+		if (!line->count
+			|| (victim->count && line->stamp < victim->stamp))
+			victim = line;
+	}
+
+	/* Miss: the following sectors are likely to be asked for next */
+	victim->count = 0;
+	if (disk_bread(sector, SDCARD_CACHE_RA, victim->data)
+			!= SDCARD_CACHE_RA) {
+		/* Maybe too close to the end of the card */
+		if (disk_bread(sector, 1, buff) != 1)
+			return RES_ERROR;
+		return RES_OK;
+	}
+
+	victim->sector = sector;
+	victim->count = SDCARD_CACHE_RA;
+	victim->stamp = ++cache_clock;
+	memcpy(buff, victim->data, SECTOR_SIZE);
+
+	return RES_OK;
+}
+#endif
+
 /*-----------------------------------------------------------------------*/
 /* Return Disk Status                                                    */
 /*-----------------------------------------------------------------------*/
@@ -48,13 +142,18 @@ DSTATUS disk_status(BYTE drv    /* Physical drive number (0..) */
 DRESULT disk_read(BYTE drv,     /* Physical drive number (0..) */
                   BYTE *buff,  /* Data buffer to store read data */
                   DWORD sector, /* Start sector number (LBA) */
-                  BYTE count    /* Sector count (1..255) */
+                  UINT count    /* Sector count (1..) */
     )
 {
 	if (drv || !count) return RES_PARERR;
 	if (Stat & STA_NOINIT) return RES_NOTRDY;
 
-	if (mmc_bread((unsigned int)sector, (unsigned int)count, (void *)buff) == count)
+#ifdef CONFIG_SDCARD_CACHE
+	if (count == 1)
+		return cache_read(buff, sector);
+#endif
+
+	if (disk_bread(sector, count, (void *)buff) == count)
 		return RES_OK;
 	else
 		return RES_ERROR;
@@ -0,0 +1,589 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "string.h"
+#include "media.h"
+#include "ext4.h"
+
+#include "debug.h"
+
+#define SECTOR_SIZE		512
+
+#define EXT4_SUPERBLOCK_OFFSET	1024
+#define EXT4_SUPER_MAGIC	0xef53
+#define EXT4_ROOT_INO		2
+#define EXT4_GOOD_OLD_INODE_SIZE	128
+#define EXT4_MIN_DESC_SIZE	32
+#define EXT4_MAX_LOG_BLOCK_SIZE	6	/* 64KiB */
+#define EXT4_NAME_LEN		255
+
+/* Superblock fields */
+#define SB_FIRST_DATA_BLOCK	0x14
+#define SB_LOG_BLOCK_SIZE	0x18
+#define SB_INODES_PER_GROUP	0x28
+#define SB_MAGIC		0x38
+#define SB_REV_LEVEL		0x4c
+#define SB_INODE_SIZE		0x58
+#define SB_FEATURE_INCOMPAT	0x60
+#define SB_DESC_SIZE		0xfe
+#define SB_SIZE			0x100
+
+#define INCOMPAT_FILETYPE	0x0002
+#define INCOMPAT_RECOVER	0x0004
+#define INCOMPAT_EXTENTS	0x0040
+#define INCOMPAT_64BIT		0x0080
+#define INCOMPAT_MMP		0x0100
+#define INCOMPAT_FLEX_BG	0x0200
+#define INCOMPAT_CSUM_SEED	0x2000
+#define INCOMPAT_LARGEDIR	0x4000
+#define INCOMPAT_INLINE_DATA	0x8000
+
+/* META_BG moves the group descriptors around, it is not handled */
+#define INCOMPAT_SUPPORTED	(INCOMPAT_FILETYPE | INCOMPAT_RECOVER \
+				| INCOMPAT_EXTENTS | INCOMPAT_64BIT \
+				| INCOMPAT_MMP | INCOMPAT_FLEX_BG \
+				| INCOMPAT_CSUM_SEED | INCOMPAT_LARGEDIR \
+				| INCOMPAT_INLINE_DATA)
+
+/* Group descriptor fields */
+#define BG_INODE_TABLE_LO	0x08
+#define BG_INODE_TABLE_HI	0x28
+
+/* Inode fields */
+#define I_MODE			0x00
+#define I_SIZE_LO		0x04
+#define I_FLAGS			0x20
+#define I_BLOCK			0x28
+#define I_SIZE_HIGH		0x6c
+#define I_READ_SIZE		0x70
+
+#define I_BLOCK_SIZE		60
+#define I_NDIR_BLOCKS		12
+#define I_IND_LEVELS		3
+
+#define S_IFMT			0xf000
+#define S_IFDIR			0x4000
+#define S_IFREG			0x8000
+
+#define EXT4_ENCRYPT_FL		0x00000800
+#define EXT4_EXTENTS_FL		0x00080000
+#define EXT4_INLINE_DATA_FL	0x10000000
+
+/* Extent tree */
+#define EXT4_EXT_MAGIC		0xf30a
+#define EXT4_EXT_NODE_SIZE	12	/* header and entries alike */
+#define EXT4_EXT_MAX_DEPTH	5
+#define EXT4_EXT_INIT_MAX_LEN	32768
+
+#define get_le16(p)	((p)[0] | ((p)[1] << 8))
+#define get_le32(p)	((p)[0] | ((p)[1] << 8) | ((p)[2] << 16) \
+				| ((unsigned int)(p)[3] << 24))
+
+struct ext4_fs {
+	unsigned int part_start;
+	unsigned int block_size;
+	unsigned int sect_per_block;
+	unsigned int first_data_block;
+	unsigned int inodes_per_group;
+	unsigned int inode_size;
+	unsigned int desc_size;
+	unsigned int incompat;
+};
+
+struct ext4_inode {
+	unsigned int mode;
+	unsigned int size;
+	unsigned int flags;
+	unsigned char block[I_BLOCK_SIZE];
+};
+
+/* A run of contiguous blocks, both logically and on the disk */
+struct ext4_run {
+	unsigned int lblk;
+	unsigned int pblk;
+	unsigned int len;
+};
+
+/* Return 0 to go on, > 0 to stop the walk, < 0 on error */
+typedef int (*ext4_run_fn)(struct ext4_run *run, void *arg);
+
+struct ext4_walk {
+	struct ext4_run run;	/* not yet reported */
+	unsigned int nr_blocks;
+	ext4_run_fn fn;
+	void *arg;
+};
+
+static struct ext4_fs fs;
+
+/* One sector window for all the metadata */
+static unsigned int sect_buf[SECTOR_SIZE / 4];
+static unsigned int sect_cached;
+static int sect_valid;
+
+static int ext4_read_bytes(unsigned int block, unsigned int offset,
+				void *buf, unsigned int len)
+{
+	unsigned char *p = buf;
+	unsigned int sector, pos, chunk;
+
+	while (len) {
+		sector = fs.part_start + block * fs.sect_per_block
+				+ offset / SECTOR_SIZE;
+		pos = offset % SECTOR_SIZE;
+		chunk = SECTOR_SIZE - pos;
+		if (chunk > len)
+			chunk = len;
+
+		if (!sect_valid || (sector != sect_cached)) {
+			sect_valid = 0;
+			if (mmc_bread(sector, 1, sect_buf) != 1)
+				return -1;
+			sect_cached = sector;
+			sect_valid = 1;
+		}
+
+		memcpy(p, (unsigned char *)sect_buf + pos, chunk);
+		p += chunk;
+		offset += chunk;
+		len -= chunk;
+	}
+
+	return 0;
+}
+
+static int ext4_read_inode(unsigned int ino, struct ext4_inode *inode)
+{
+	unsigned char buf[I_READ_SIZE];
+	unsigned int group, index, table;
+
+	if ((ino == 0) || (fs.inodes_per_group == 0))
+		return -1;
+
+	group = (ino - 1) / fs.inodes_per_group;
+	index = (ino - 1) % fs.inodes_per_group;
+
+	if (ext4_read_bytes(fs.first_data_block + 1, group * fs.desc_size,
+				buf, fs.desc_size > 64 ? 64 : fs.desc_size))
+		return -1;
+
+	table = get_le32(buf + BG_INODE_TABLE_LO);
+	if ((fs.desc_size >= 64) && get_le32(buf + BG_INODE_TABLE_HI))
+		return -1;
+
+	if (ext4_read_bytes(table, index * fs.inode_size, buf, I_READ_SIZE))
+		return -1;
+
+	inode->mode = get_le16(buf + I_MODE);
+	inode->size = get_le32(buf + I_SIZE_LO);
+	inode->flags = get_le32(buf + I_FLAGS);
+	memcpy(inode->block, buf + I_BLOCK, I_BLOCK_SIZE);
+
+	/* Files over 4GiB can't be loaded anyway */
+	if (((inode->mode & S_IFMT) == S_IFREG) && get_le32(buf + I_SIZE_HIGH))
+		return -1;
+
+	return 0;
+}
+
+/* Merge the blocks into runs as large as possible */
+static int ext4_walk_add(struct ext4_walk *w, unsigned int lblk,
+				unsigned int pblk, unsigned int len)
+{
+	struct ext4_run *run = &w->run;
+	int ret;
+
+	if (lblk >= w->nr_blocks)
+		return 0;
+	if (len > w->nr_blocks - lblk)
+		len = w->nr_blocks - lblk;
+
+	if (run->len && (run->lblk + run->len == lblk)
+			&& (run->pblk + run->len == pblk)) {
+		run->len += len;
+		return 0;
+	}
+
+	if (run->len) {
+		ret = w->fn(run, w->arg);
+		if (ret)
+			return ret;
+	}
+
+	run->lblk = lblk;
+	run->pblk = pblk;
+	run->len = len;
+
+	return 0;
+}
+
+static int ext4_walk_flush(struct ext4_walk *w)
+{
+	int ret = 0;
+
+	if (w->run.len)
+		ret = w->fn(&w->run, w->arg);
+	w->run.len = 0;
+
+	return ret;
+}
+
+/* The root node lives in i_block, the others in their own block */
+static int ext4_extent_walk(struct ext4_walk *w, const unsigned char *root,
+				unsigned int block, int level)
+{
+	unsigned char node[EXT4_EXT_NODE_SIZE];
+	unsigned int entries, depth, offset, len;
+	unsigned int i;
+	int ret;
+
+	if (level > EXT4_EXT_MAX_DEPTH)
+		return -1;
+
+	if (root)
+		memcpy(node, root, EXT4_EXT_NODE_SIZE);
+	else if (ext4_read_bytes(block, 0, node, EXT4_EXT_NODE_SIZE))
+		return -1;
+
+	if (get_le16(node) != EXT4_EXT_MAGIC)
+		return -1;
+
+	entries = get_le16(node + 2);
+	depth = get_le16(node + 6);
+
+	for (i = 0; i < entries; i++) {
+		offset = (i + 1) * EXT4_EXT_NODE_SIZE;
+		if (root) {
+			if (offset + EXT4_EXT_NODE_SIZE > I_BLOCK_SIZE)
+				return -1;
+			memcpy(node, root + offset, EXT4_EXT_NODE_SIZE);
+		} else if (ext4_read_bytes(block, offset, node,
+					EXT4_EXT_NODE_SIZE))
+			return -1;
+
+		if (depth) {
+			/* Index: ei_block, ei_leaf_lo, ei_leaf_hi */
+			if (get_le16(node + 8))
+				return -1;
+
+			ret = ext4_extent_walk(w, 0, get_le32(node + 4),
+						level + 1);
+		} else {
+			/* Leaf: ee_block, ee_len, ee_start_hi, ee_start_lo */
+			len = get_le16(node + 4);
+
+			/* Uninitialized extents read back as zeroes */
+			if (len > EXT4_EXT_INIT_MAX_LEN)
+				continue;
+
+			if (get_le16(node + 6))
+				return -1;
+
+			ret = ext4_walk_add(w, get_le32(node),
+						get_le32(node + 8), len);
+		}
+
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+static unsigned int ext4_ind_span(int level)
+{
+	unsigned int span = 1;
+
+	while (level--)
+		span *= fs.block_size / 4;
+
+	return span;
+}
+
+/* ext2/ext3 (in)direct block map, level 0 pointing to data blocks */
+static int ext4_indirect_walk(struct ext4_walk *w, unsigned int block,
+				int level, unsigned int *lblk)
+{
+	unsigned char ptr[4];
+	unsigned int i, pblk;
+	int ret;
+
+	for (i = 0; (i < fs.block_size / 4) && (*lblk < w->nr_blocks); i++) {
+		if (ext4_read_bytes(block, i * 4, ptr, 4))
+			return -1;
+
+		pblk = get_le32(ptr);
+		if (!pblk) {
+			*lblk += ext4_ind_span(level);
+			continue;
+		}
+
+		if (level) {
+			ret = ext4_indirect_walk(w, pblk, level - 1, lblk);
+		} else {
+			ret = ext4_walk_add(w, *lblk, pblk, 1);
+			(*lblk)++;
+		}
+
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+static int ext4_inode_walk(struct ext4_inode *inode,
+				ext4_run_fn fn, void *arg)
+{
+	struct ext4_walk w;
+	unsigned int lblk, pblk;
+	int i, ret = 0;
+
+	if (inode->flags & (EXT4_INLINE_DATA_FL | EXT4_ENCRYPT_FL)) {
+		dbg_log(1, "EXT4: Inline or encrypted data not supported\n\r");
+		return -1;
+	}
+
+	w.run.len = 0;
+	w.nr_blocks = (inode->size + fs.block_size - 1) / fs.block_size;
+	w.fn = fn;
+	w.arg = arg;
+
+	if (inode->flags & EXT4_EXTENTS_FL) {
+		ret = ext4_extent_walk(&w, inode->block, 0, 0);
+	} else {
+		for (i = 0, lblk = 0; (i < I_NDIR_BLOCKS) && !ret; i++, lblk++) {
+			pblk = get_le32(inode->block + i * 4);
+			if (pblk)
+				ret = ext4_walk_add(&w, lblk, pblk, 1);
+		}
+
+		for (i = 0; (i < I_IND_LEVELS) && !ret
+				&& (lblk < w.nr_blocks); i++) {
+			pblk = get_le32(inode->block + (I_NDIR_BLOCKS + i) * 4);
+			if (pblk)
+				ret = ext4_indirect_walk(&w, pblk, i, &lblk);
+			else
+				lblk += ext4_ind_span(i + 1);
+		}
+	}
+
+	if (ret)
+		return ret;
+
+	return ext4_walk_flush(&w);
+}
+
+struct ext4_dir_search {
+	const char *name;
+	unsigned int name_len;
+	unsigned int ino;
+};
+
+static int ext4_dir_scan(struct ext4_run *run, void *arg)
+{
+	struct ext4_dir_search *search = arg;
+	unsigned char de[8];
+	char name[EXT4_NAME_LEN];
+	unsigned int block, offset, rec_len;
+
+	for (block = run->pblk; block < run->pblk + run->len; block++) {
+		for (offset = 0; offset + sizeof(de) <= fs.block_size;
+				offset += rec_len) {
+			/* inode, rec_len, name_len, file_type */
+			if (ext4_read_bytes(block, offset, de, sizeof(de)))
+				return -1;
+
+			rec_len = get_le16(de + 4);
+			if ((rec_len < sizeof(de)) || (rec_len & 3)
+					|| (offset + rec_len > fs.block_size))
+				return -1;
+
+			if (!get_le32(de) || (de[6] != search->name_len))
+				continue;
+
+			if (ext4_read_bytes(block, offset + sizeof(de),
+						name, search->name_len))
+				return -1;
+
+			if (!memcmp(name, search->name, search->name_len)) {
+				search->ino = get_le32(de);
+				return 1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+static int ext4_lookup(const char *path, struct ext4_inode *inode)
+{
+	struct ext4_dir_search search;
+	unsigned int ino = EXT4_ROOT_INO;
+	const char *p = path;
+	int ret;
+
+	for (;;) {
+		if (ext4_read_inode(ino, inode))
+			return -1;
+
+		while (*p == '/')
+			p++;
+		if (*p == '\0')
+			return 0;
+
+		if ((inode->mode & S_IFMT) != S_IFDIR)
+			return -1;
+
+		search.name = p;
+		while (*p && (*p != '/'))
+			p++;
+		search.name_len = p - search.name;
+		search.ino = 0;
+		if (search.name_len > EXT4_NAME_LEN)
+			return -1;
+
+		ret = ext4_inode_walk(inode, ext4_dir_scan, &search);
+		if (ret <= 0)
+			return -1;
+
+		ino = search.ino;
+	}
+}
+
+struct ext4_file_read {
+	unsigned char *dest;
+	unsigned int size;
+	unsigned int pos;	/* bytes written so far */
+};
+
+/* Each run goes to its final place with a single mmc_bread() */
+static int ext4_file_copy(struct ext4_run *run, void *arg)
+{
+	struct ext4_file_read *file = arg;
+	unsigned int start = run->lblk * fs.block_size;
+	unsigned int bytes = run->len * fs.block_size;
+	unsigned int count;
+
+	/* Sparse blocks before this run */
+	if (start > file->pos)
+		memset(file->dest + file->pos, 0, start - file->pos);
+
+	if (bytes > file->size - start)
+		bytes = file->size - start;
+
+	count = (bytes + SECTOR_SIZE - 1) / SECTOR_SIZE;
+	if (mmc_bread(fs.part_start + run->pblk * fs.sect_per_block,
+			count, file->dest + start) != count)
+		return -1;
+
+	file->pos = start + bytes;
+
+	return 0;
+}
+
+int ext4_mount(unsigned int part_start)
+{
+	unsigned char sb[SB_SIZE];
+	unsigned int log_block_size, rev_level;
+
+	/* Start with 1KiB blocks, the superblock is block 1 */
+	fs.part_start = part_start;
+	fs.block_size = 1024;
+	fs.sect_per_block = fs.block_size / SECTOR_SIZE;
+	sect_valid = 0;
+
+	if (ext4_read_bytes(0, EXT4_SUPERBLOCK_OFFSET, sb, SB_SIZE))
+		return -1;
+
+	if (get_le16(sb + SB_MAGIC) != EXT4_SUPER_MAGIC) {
+		dbg_log(1, "EXT4: Bad superblock magic\n\r");
+		return -1;
+	}
+
+	log_block_size = get_le32(sb + SB_LOG_BLOCK_SIZE);
+	if (log_block_size > EXT4_MAX_LOG_BLOCK_SIZE)
+		return -1;
+
+	fs.block_size = 1024 << log_block_size;
+	fs.sect_per_block = fs.block_size / SECTOR_SIZE;
+	fs.first_data_block = get_le32(sb + SB_FIRST_DATA_BLOCK);
+	fs.inodes_per_group = get_le32(sb + SB_INODES_PER_GROUP);
+
+	rev_level = get_le32(sb + SB_REV_LEVEL);
+	fs.inode_size = rev_level ? get_le16(sb + SB_INODE_SIZE)
+				: EXT4_GOOD_OLD_INODE_SIZE;
+	if (fs.inode_size < EXT4_GOOD_OLD_INODE_SIZE)
+		return -1;
+
+	fs.incompat = rev_level ? get_le32(sb + SB_FEATURE_INCOMPAT) : 0;
+	if (fs.incompat & ~INCOMPAT_SUPPORTED) {
+		dbg_log(1, "EXT4: Unsupported features: %d\n\r",
+			fs.incompat & ~INCOMPAT_SUPPORTED);
+		return -1;
+	}
+
+	if (fs.incompat & INCOMPAT_RECOVER)
+		dbg_log(1, "EXT4: Journal needs recovery, reading anyway\n\r");
+
+	fs.desc_size = EXT4_MIN_DESC_SIZE;
+	if (fs.incompat & INCOMPAT_64BIT)
+		fs.desc_size = get_le16(sb + SB_DESC_SIZE);
+	if (fs.desc_size < EXT4_MIN_DESC_SIZE)
+		return -1;
+
+	return 0;
+}
+
+int ext4_load(const char *path, unsigned char *dest, unsigned int *length)
+{
+	struct ext4_inode inode;
+	struct ext4_file_read file;
+
+	if (ext4_lookup(path, &inode)) {
+		dbg_log(1, "EXT4: %s not found\n\r", path);
+		return -1;
+	}
+
+	if ((inode.mode & S_IFMT) != S_IFREG)
+		return -1;
+
+	file.dest = dest;
+	file.size = inode.size;
+	file.pos = 0;
+
+	if (ext4_inode_walk(&inode, ext4_file_copy, &file))
+		return -1;
+
+	/* Sparse blocks at the end of the file */
+	if (file.pos < file.size)
+		memset(dest + file.pos, 0, file.size - file.pos);
+
+	*length = inode.size;
+
+	return 0;
+}
@@ -0,0 +1,6 @@
+# Makefile for AT91Bootstrap ./fs/src directory
+# DIRS				+= ./fs/src
+
+FS_EXT4:=$(TOPDIR)/fs/src
+
+COBJS-$(CONFIG_SDCARD_EXT4)	+=  $(FS_EXT4)/ext4.o
@@ -3,7 +3,9 @@
 
 FS_FAT:=$(TOPDIR)/fs/src
 
+ifeq ($(CONFIG_SDCARD_RAW)$(CONFIG_SDCARD_EXT4),)
 COBJS-$(CONFIG_SDCARD)	+=  $(FS_FAT)/ff.o
 COBJS-$(CONFIG_SDCARD)	+=  $(FS_FAT)/diskio.o
+endif
 
 
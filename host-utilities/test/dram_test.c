@@ -0,0 +1,170 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * Host test of ddramc_timing() and sdramc_timing(): the memories of the
+ * 9x5-EK and 9263-EK go through the conversion at the clocks those boards
+ * run at, and must give the register values the boards used to hard-code.
+ */
+#include <stdio.h>
+#include <stdarg.h>
+
+#include "dram_timing.h"
+#include "dram_parts.h"
+#include "ddramc.h"
+#include "sdramc.h"
+#include "arch/at91_ddrsdrc.h"
+#include "arch/at91_sdramc.h"
+
+#define SDRAMC_TIMINGS	(AT91C_SDRAMC_TWR | AT91C_SDRAMC_TRC \
+			| AT91C_SDRAMC_TRP | AT91C_SDRAMC_TRCD \
+			| AT91C_SDRAMC_TRAS | AT91C_SDRAMC_TXS)
+
+/* Geometry of the 32-bit 9263-EK SDRAM, must come out untouched */
+#define SDRAMC_GEOMETRY	(AT91C_SDRAMC_NC_9 | AT91C_SDRAMC_NR_13 \
+			| AT91C_SDRAMC_CAS_2 | AT91C_SDRAMC_NB_4_BANKS \
+			| AT91C_SDRAMC_DBW_32_BITS)
+
+static const struct dram_timing mt47h64m16hr_3 = DRAM_MT47H64M16HR_3;
+static const struct dram_timing mt48lc16m16a2_75 = DRAM_MT48LC16M16A2_75;
+
+static int failures;
+static int quiet;
+
+/* ddramc.c waits for the memory, no need to here */
+void delay(unsigned int loops)
+{
+}
+
+int dbg_log(const char level, const char *fmt_str, ...)
+{
+	va_list ap;
+
+	if (quiet)
+		return 0;
+
+	va_start(ap, fmt_str);
+	vfprintf(stderr, fmt_str, ap);
+	va_end(ap);
+
+	return 0;
+}
+
+static void expect(const char *what, unsigned int mck,
+			unsigned int value, unsigned int expected)
+{
+	if (value == expected)
+		return;
+
+	printf("%s at %u Hz: 0x%08x, expected 0x%08x\n",
+		what, mck, value, expected);
+	failures++;
+}
+
+static void test_ddramc(void)
+{
+	struct ddramc_register reg;
+	unsigned int mck = 132096000;	/* 9x5-EK */
+	int ret;
+
+	if (ddramc_timing(&reg, &mt47h64m16hr_3, mck)) {
+		printf("DDRAM: ddramc_timing() failed at %u Hz\n", mck);
+		failures++;
+		return;
+	}
+
+	/* at91sam9x5ek.c before the timings were derived */
+	expect("DDRAM T0PR", mck, reg.t0pr,
+		AT91C_DDRC2_TRAS_6 | AT91C_DDRC2_TRCD_2 | AT91C_DDRC2_TWR_2
+		| AT91C_DDRC2_TRC_8 | AT91C_DDRC2_TRP_2 | AT91C_DDRC2_TRRD_2
+		| AT91C_DDRC2_TWTR_2 | AT91C_DDRC2_TMRD_2);
+	expect("DDRAM T1PR", mck, reg.t1pr,
+		AT91C_DDRC2_TXP_2 | 200 << 16 | 19 << 8 | AT91C_DDRC2_TRFC_18);
+	expect("DDRAM T2PR", mck, reg.t2pr,
+		AT91C_DDRC2_TFAW_7 | AT91C_DDRC2_TRTP_2 | AT91C_DDRC2_TRPA_3
+		| AT91C_DDRC2_TXARDS_7 | AT91C_DDRC2_TXARD_2);
+
+	/* 7.8 us at 132 MHz, the old 0x411 was 7.88 us */
+	expect("DDRAM RTR", mck, reg.rtr, 1029);
+
+	/* tRAS does not fit in 4 bits any more */
+	quiet = 1;
+	ret = ddramc_timing(&reg, &mt47h64m16hr_3, 400000000);
+	quiet = 0;
+	if (ret != -1) {
+		printf("DDRAM: saturation not reported\n");
+		failures++;
+	}
+}
+
+static void test_sdramc_at(unsigned int mck, unsigned int timings,
+				unsigned int tr)
+{
+	struct sdramc_register reg;
+
+	reg.cr = SDRAMC_GEOMETRY | SDRAMC_TIMINGS;
+	if (sdramc_timing(&reg, &mt48lc16m16a2_75, mck)) {
+		printf("SDRAM: sdramc_timing() failed at %u Hz\n", mck);
+		failures++;
+		return;
+	}
+
+	expect("SDRAM CR", mck, reg.cr, SDRAMC_GEOMETRY | timings);
+	expect("SDRAM TR", mck, reg.tr, tr);
+}
+
+static void test_sdramc(void)
+{
+	/* at91sam9263ek.c before the timings were derived */
+	const unsigned int old = AT91C_SDRAMC_TWR_2 | AT91C_SDRAMC_TRC_7
+				| AT91C_SDRAMC_TRP_2 | AT91C_SDRAMC_TRCD_2
+				| AT91C_SDRAMC_TRAS_5 | AT91C_SDRAMC_TXSR_8;
+
+	/* 200 MHz from either crystal, refresh 7.8 us instead of 7 us */
+	test_sdramc_at(198656000 / 2, old, 773);
+	test_sdramc_at(199919000 / 2, old, 773);
+
+	/* The 240 MHz boost: all but tWR need one more cycle */
+	test_sdramc_at(240000000 / 2,
+		AT91C_SDRAMC_TWR_2 | AT91C_SDRAMC_TRC_8
+		| AT91C_SDRAMC_TRP_3 | AT91C_SDRAMC_TRCD_3
+		| AT91C_SDRAMC_TRAS_6 | AT91C_SDRAMC_TXSR_9, 937);
+}
+
+int main(void)
+{
+	test_ddramc();
+	test_sdramc();
+
+	if (failures) {
+		printf("dram: %d failures\n", failures);
+		return 1;
+	}
+
+	printf("dram: 9x5-EK DDR2 and 9263-EK SDRAM timings ok\n");
+	return 0;
+}
@@ -0,0 +1,147 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * Host test of fs/src/ext4.c: loads files from an ext2/3/4 image with
+ * ext4_load() and compares them with the files the image was made from.
+ *
+ *   ext4_test <image> <path> <reference> [<path> <reference>]...
+ *
+ * A reference of "-" means the path must not be found.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "host_card.h"
+#include "ext4.h"
+
+#define SECTOR_SIZE	512
+#define GUARD		4096
+#define GUARD_BYTE	0xa5
+
+static unsigned char *read_file(const char *path, unsigned int *size)
+{
+	struct stat st;
+	unsigned char *buf;
+	FILE *f;
+
+	f = fopen(path, "rb");
+	if (!f || fstat(fileno(f), &st)) {
+		perror(path);
+		exit(2);
+	}
+
+	buf = malloc(st.st_size + 1);
+	if (fread(buf, 1, st.st_size, f) != st.st_size) {
+		perror(path);
+		exit(2);
+	}
+	fclose(f);
+
+	*size = st.st_size;
+	return buf;
+}
+
+static int check_file(const char *path, const char *ref_path)
+{
+	unsigned char *ref, *dest;
+	unsigned int ref_size, length, room, i;
+	int ret = 0;
+
+	if (!strcmp(ref_path, "-")) {
+		unsigned char dummy[SECTOR_SIZE];
+
+		if (ext4_load(path, dummy, &length) == 0) {
+			printf("FAIL %s: found, should not exist\n", path);
+			return 1;
+		}
+		return 0;
+	}
+
+	ref = read_file(ref_path, &ref_size);
+
+	/* The loader reads whole sectors, nothing may go past them */
+	room = (ref_size + SECTOR_SIZE - 1) & ~(SECTOR_SIZE - 1);
+	dest = malloc(room + GUARD);
+	memset(dest, GUARD_BYTE, room + GUARD);
+
+	length = 0;
+	if (ext4_load(path, dest, &length)) {
+		printf("FAIL %s: not loaded\n", path);
+		ret = 1;
+	} else if (length != ref_size) {
+		printf("FAIL %s: length %u, expected %u\n",
+			path, length, ref_size);
+		ret = 1;
+	} else if (memcmp(dest, ref, ref_size)) {
+		for (i = 0; dest[i] == ref[i]; i++)
+			;
+		printf("FAIL %s: differs at offset %u\n", path, i);
+		ret = 1;
+	} else {
+		for (i = room; i < room + GUARD; i++)
+			if (dest[i] != GUARD_BYTE)
+				break;
+		if (i != room + GUARD) {
+			printf("FAIL %s: wrote past the end, offset %u\n",
+				path, i);
+			ret = 1;
+		}
+	}
+
+	free(dest);
+	free(ref);
+	return ret;
+}
+
+int main(int argc, char *argv[])
+{
+	int i, failures = 0;
+
+	if ((argc < 2) || (argc & 1)) {
+		fprintf(stderr, "usage: %s <image> [<path> <reference>]...\n",
+			argv[0]);
+		return 2;
+	}
+
+	if (host_card_open(argv[1]))
+		return 2;
+
+	if (ext4_mount(0)) {
+		printf("FAIL %s: not mounted\n", argv[1]);
+		return 1;
+	}
+
+	for (i = 2; i < argc; i += 2)
+		failures += check_file(argv[i], argv[i + 1]);
+
+	host_card_close();
+
+	return failures ? 1 : 0;
+}
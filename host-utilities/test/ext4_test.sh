@@ -0,0 +1,127 @@
+#!/bin/bash
+#
+# Builds ext2/ext3/ext4 images with mke2fs from a known tree and checks
+# that ext4_load() reads every file back as it was. The images cover
+# indirect blocks, extent trees of more than one level, htree
+# directories, holes and uninitialized extents.
+#
+#   ext4_test.sh <ext4_test program> [work directory]
+#
+
+set -e
+
+TEST=$1
+WORK=${2:-$(mktemp -d)}
+SRC=$WORK/src
+
+PATH=$PATH:/sbin:/usr/sbin
+
+for tool in mke2fs e2fsck debugfs; do
+	if ! which $tool > /dev/null 2>&1; then
+		echo "ext4: $tool not found, skipped"
+		exit 0
+	fi
+done
+
+rm -fr $SRC
+mkdir -p $SRC/boot $SRC/deep/a/b/c $SRC/many
+
+# A kernel sized file reaches the double indirect blocks at 1KiB
+head -c 1572864 /dev/urandom > $SRC/boot/zImage
+head -c 100 /dev/urandom > $SRC/boot/small
+head -c 4096 /dev/urandom > $SRC/boot/block
+: > $SRC/boot/empty
+head -c 777 /dev/urandom > $SRC/deep/a/b/c/file
+
+# Holes at the start, in the middle and at the end
+truncate -s 2097152 $SRC/boot/sparse
+echo middle | dd of=$SRC/boot/sparse bs=1 seek=1000000 conv=notrunc 2> /dev/null
+echo end | dd of=$SRC/boot/sparse bs=1 seek=2097000 conv=notrunc 2> /dev/null
+head -c 10000 /dev/urandom > $SRC/boot/sparse_tail
+truncate -s 300000 $SRC/boot/sparse_tail
+
+# Enough entries for e2fsck -D to index the directory
+for i in $(seq 1 400); do
+	echo "entry $i" > $SRC/many/a_rather_long_file_name_$i
+done
+
+# Written after the filler files are freed, so it lands in many pieces
+head -c 700000 /dev/urandom > $WORK/frag
+# Gets uninitialized extents past its data
+head -c 5000 /dev/urandom > $WORK/prealloc
+cp $WORK/prealloc $WORK/prealloc.ref
+truncate -s 65536 $WORK/prealloc.ref
+
+fragment()
+{
+	local img=$1
+	local cmds=$WORK/debugfs.cmd
+
+	echo "mkdir /fill" > $cmds
+	for i in $(seq 1 300); do
+		echo "write $SRC/boot/block /fill/$i" >> $cmds
+	done
+	for i in $(seq 1 2 300); do
+		echo "rm /fill/$i" >> $cmds
+	done
+	echo "write $WORK/frag /boot/frag" >> $cmds
+	debugfs -w -f $cmds $img > /dev/null 2>&1
+}
+
+preallocate()
+{
+	local img=$1
+
+	debugfs -w -f - $img > /dev/null 2>&1 <<-EOC
+		write $WORK/prealloc /boot/prealloc
+		fallocate /boot/prealloc 0 63
+		sif /boot/prealloc size 65536
+	EOC
+}
+
+failures=0
+
+check()
+{
+	local name=$1
+	local type=$2
+	shift 2
+	local img=$WORK/$name.img
+	local args=""
+
+	rm -f $img
+	mke2fs -q -F -t $type "$@" -d $SRC $img 64M > /dev/null
+	# Turn the large directories into htrees
+	e2fsck -fyD $img > /dev/null 2>&1 || [ $? -le 1 ]
+
+	fragment $img
+	args="/boot/frag $WORK/frag"
+
+	if [ $type = ext4 ]; then
+		preallocate $img
+		args="$args /boot/prealloc $WORK/prealloc.ref"
+	fi
+
+	for f in $(cd $SRC && find . -type f | sed 's|^\.||'); do
+		args="$args $f $SRC$f"
+	done
+
+	args="$args /boot/missing - /many/a_rather_long_file_name_401 -"
+	args="$args /boot/zImage/x - /nodir/zImage -"
+
+	if $TEST $img $args; then
+		echo "ext4: $name ok"
+	else
+		echo "ext4: $name FAILED"
+		failures=$((failures + 1))
+	fi
+}
+
+check ext2-1k ext2 -b 1024
+check ext2-4k ext2 -b 4096
+check ext3-1k ext3 -b 1024
+check ext4-1k ext4 -b 1024
+check ext4-4k ext4 -b 4096
+check ext4-32bit ext4 -b 4096 -O ^64bit,^metadata_csum
+
+exit $failures
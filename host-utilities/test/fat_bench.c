@@ -0,0 +1,326 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * Host benchmark of the FAT loader: driver/sdcard.c, fs/src/ff.c and
+ * fs/src/diskio.c load a kernel from FAT images made here, with the
+ * file split into more and more fragments. The card counts commands
+ * and sectors and turns them into bus time.
+ *
+ *   fat_bench [-b] [-v] <directory>
+ *
+ * Without -b every image is only checked to load correctly.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "host_card.h"
+#include "common.h"
+#include "sdcard.h"
+
+#define SECTOR_SIZE	512
+#define FILE_SIZE	(4 << 20)
+#define FILE_NAME	"ZIMAGE"
+#define GUARD		(SECTOR_SIZE * 2)
+#define GUARD_BYTE	0xa5
+
+struct layout {
+	int fat32;
+	unsigned int spc;		/* Sectors per cluster */
+	unsigned int frags;		/* Fragments of the file */
+};
+
+static const struct layout layouts[] = {
+	{0, 1, 1}, {0, 1, 4}, {0, 1, 31}, {0, 1, 32}, {0, 1, 128},
+	{0, 8, 1}, {0, 8, 4}, {0, 8, 31}, {0, 8, 32}, {0, 8, 128},
+	{0, 64, 1}, {0, 64, 4}, {0, 64, 31}, {0, 64, 32}, {0, 64, 128},
+	{1, 8, 1}, {1, 8, 4}, {1, 8, 31}, {1, 8, 32}, {1, 8, 128},
+};
+
+static unsigned char *content;
+
+static void put16(unsigned char *p, unsigned int v)
+{
+	p[0] = v;
+	p[1] = v >> 8;
+}
+
+static void put32(unsigned char *p, unsigned int v)
+{
+	put16(p, v);
+	put16(p + 2, v >> 16);
+}
+
+static void set_fat(unsigned char *fat, int fat32, unsigned int clst,
+			unsigned int val)
+{
+	if (fat32)
+		put32(fat + clst * 4, val & 0x0fffffff);
+	else
+		put16(fat + clst * 2, val);
+}
+
+static int write_at(int fd, const void *buf, size_t len, unsigned int sector)
+{
+	if (pwrite(fd, buf, len, (off_t)sector * SECTOR_SIZE) != (ssize_t)len) {
+		perror("pwrite");
+		return -1;
+	}
+	return 0;
+}
+
+/*
+ * Superfloppy volume (boot sector at sector 0), two FATs, the file in
+ * the root directory. Fragments are laid out in order with a free
+ * cluster between them, so none of them can be merged.
+ */
+static int make_image(const char *path, const struct layout *l)
+{
+	unsigned int csize = l->spc * SECTOR_SIZE;
+	unsigned int nfile = (FILE_SIZE + csize - 1) / csize;
+	unsigned int first = l->fat32 ? 3 : 2;	/* FAT32: root dir in cluster 2 */
+	unsigned int nclst, fatsz, rsvd, rootsecs, database, total;
+	unsigned int clst, frag, len, done, prev, i;
+	unsigned char bs[SECTOR_SIZE], dir[SECTOR_SIZE];
+	unsigned char *fat;
+	int fd, ret = -1;
+
+	nclst = first + nfile + l->frags;
+	if (l->fat32) {
+		if (nclst < 65536)
+			nclst = 65536;
+		rsvd = 32;
+		rootsecs = 0;
+		fatsz = ((nclst + 2) * 4 + SECTOR_SIZE - 1) / SECTOR_SIZE;
+	} else {
+		if (nclst < 4096)
+			nclst = 4096;
+		rsvd = 1;
+		rootsecs = 512 * 32 / SECTOR_SIZE;
+		fatsz = ((nclst + 2) * 2 + SECTOR_SIZE - 1) / SECTOR_SIZE;
+	}
+	database = rsvd + 2 * fatsz + rootsecs;
+	total = database + nclst * l->spc;
+
+	memset(bs, 0, sizeof(bs));
+	bs[0] = 0xeb;
+	bs[1] = 0x3c;
+	bs[2] = 0x90;
+	memcpy(bs + 3, "MSWIN4.1", 8);
+	put16(bs + 11, SECTOR_SIZE);
+	bs[13] = l->spc;
+	put16(bs + 14, rsvd);
+	bs[16] = 2;
+	put16(bs + 17, l->fat32 ? 0 : 512);
+	if (total < 0x10000)
+		put16(bs + 19, total);
+	else
+		put32(bs + 32, total);
+	bs[21] = 0xf8;
+	put16(bs + 24, 63);
+	put16(bs + 26, 255);
+	if (l->fat32) {
+		put32(bs + 36, fatsz);
+		put32(bs + 44, 2);		/* Root directory cluster */
+		put16(bs + 48, 1);
+		put16(bs + 50, 6);
+		bs[64] = 0x80;
+		bs[66] = 0x29;
+		memcpy(bs + 71, "NO NAME    FAT32   ", 19);
+	} else {
+		put16(bs + 22, fatsz);
+		bs[36] = 0x80;
+		bs[38] = 0x29;
+		memcpy(bs + 43, "NO NAME    FAT16   ", 19);
+	}
+	bs[510] = 0x55;
+	bs[511] = 0xaa;
+
+	memset(dir, 0, sizeof(dir));
+	memcpy(dir, "ZIMAGE     ", 11);
+	dir[11] = 0x20;				/* Archive */
+	put16(dir + 20, first >> 16);
+	put16(dir + 26, first);
+	put32(dir + 28, FILE_SIZE);
+
+	fat = calloc(fatsz, SECTOR_SIZE);
+	if (!fat)
+		return -1;
+	set_fat(fat, l->fat32, 0, 0xfffffff8);
+	set_fat(fat, l->fat32, 1, 0xffffffff);
+	if (l->fat32)
+		set_fat(fat, 1, 2, 0xffffffff);
+
+	fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) {
+		perror(path);
+		goto out;
+	}
+	if (ftruncate(fd, (off_t)total * SECTOR_SIZE)) {
+		perror(path);
+		goto out;
+	}
+
+	clst = first;
+	prev = 0;
+	done = 0;
+	for (frag = 0; frag < l->frags; frag++) {
+		len = nfile / l->frags + (frag < nfile % l->frags);
+		for (i = 0; i < len; i++, clst++) {
+			if (prev)
+				set_fat(fat, l->fat32, prev, clst);
+			prev = clst;
+		}
+		if (write_at(fd, content + done, len * csize,
+				database + (clst - len - 2) * l->spc))
+			goto out;
+		done += len * csize;
+		clst++;				/* Gap */
+	}
+	set_fat(fat, l->fat32, prev, 0xffffffff);
+
+	if (write_at(fd, bs, SECTOR_SIZE, 0)
+	    || write_at(fd, fat, fatsz * SECTOR_SIZE, rsvd)
+	    || write_at(fd, fat, fatsz * SECTOR_SIZE, rsvd + fatsz)
+	    || write_at(fd, dir, SECTOR_SIZE,
+			l->fat32 ? database : rsvd + 2 * fatsz))
+		goto out;
+
+	ret = 0;
+out:
+	if (fd >= 0)
+		close(fd);
+	free(fat);
+	return ret;
+}
+
+static int run(const char *dir, const struct layout *l, int bench)
+{
+	struct image_info img;
+	struct host_card_stats st;
+	unsigned char *dest;
+	char path[512];
+	double ms;
+	int i, ret = -1;
+
+	snprintf(path, sizeof(path), "%s/fat%d-%u-%u.img",
+		dir, l->fat32 ? 32 : 16, l->spc * SECTOR_SIZE, l->frags);
+	if (make_image(path, l))
+		return -1;
+
+	dest = malloc(FILE_SIZE + GUARD);
+	if (!dest || host_card_open(path))
+		goto out;
+	memset(dest, GUARD_BYTE, FILE_SIZE + GUARD);
+
+	memset(&img, 0, sizeof(img));
+	img.filename = FILE_NAME;
+	img.dest = dest;
+
+	host_card_reset_stats();
+	if (load_sdcard(&img)) {
+		fprintf(stderr, "%s: load_sdcard() failed\n", path);
+		goto out;
+	}
+	host_card_get_stats(&st);
+
+	if (memcmp(dest, content, FILE_SIZE)) {
+		fprintf(stderr, "%s: content differs\n", path);
+		goto out;
+	}
+	for (i = FILE_SIZE; i < FILE_SIZE + GUARD; i++)
+		if (dest[i] != GUARD_BYTE) {
+			fprintf(stderr, "%s: written past the file\n", path);
+			goto out;
+		}
+
+	ms = st.busy_ns / 1e6;
+	if (bench)
+		printf("FAT%-2d %6u %6u %8u %8u %10.1f %8.2f\n",
+			l->fat32 ? 32 : 16, l->spc * SECTOR_SIZE, l->frags,
+			st.commands, st.sectors, ms,
+			FILE_SIZE / ms / 1000.0);
+	ret = 0;
+out:
+	host_card_close();
+	unlink(path);
+	free(dest);
+	return ret;
+}
+
+int main(int argc, char **argv)
+{
+	unsigned int seed = 1;
+	unsigned int i;
+	int bench = 0;
+	int ret = 0;
+	int opt;
+
+	host_card_quiet = 1;
+	while ((opt = getopt(argc, argv, "bv")) != -1) {
+		switch (opt) {
+		case 'b':
+			bench = 1;
+			break;
+		case 'v':
+			host_card_quiet = 0;
+			break;
+		default:
+			goto usage;
+		}
+	}
+	if (optind != argc - 1)
+		goto usage;
+
+	content = malloc(FILE_SIZE);
+	if (!content)
+		return 2;
+	for (i = 0; i < FILE_SIZE; i++) {
+		seed = seed * 1103515245 + 12345;
+		content[i] = seed >> 16;
+	}
+
+	if (bench)
+		printf("FAT   clust   frags     cmds  sectors    bus(ms)     MB/s\n");
+
+	for (i = 0; i < sizeof(layouts) / sizeof(layouts[0]); i++)
+		if (run(argv[optind], &layouts[i], bench))
+			ret = 1;
+
+	if (!bench)
+		printf("fat: %s\n", ret ? "FAILED" : "ok");
+
+	free(content);
+	return ret;
+
+usage:
+	fprintf(stderr, "usage: %s [-b] [-v] <directory>\n", argv[0]);
+	return 2;
+}
@@ -0,0 +1,127 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stdio.h>
+#include <stdarg.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "host_card.h"
+
+#define SECTOR_SIZE	512
+
+static int card_fd = -1;
+
+int host_card_quiet;
+
+/*
+ * Card model: fixed cost per command (command, access time, stop) plus
+ * transfer time per sector, about a 25 MHz 4-bit bus by default.
+ */
+static unsigned int cmd_ns = 500000;
+static unsigned int sector_ns = 41000;
+
+static unsigned int nr_cmds;
+static unsigned int nr_sectors;
+static unsigned long long busy_ns;
+
+int host_card_open(const char *path)
+{
+	card_fd = open(path, O_RDONLY);
+	if (card_fd < 0) {
+		perror(path);
+		return -1;
+	}
+
+	return 0;
+}
+
+void host_card_close(void)
+{
+	if (card_fd >= 0)
+		close(card_fd);
+	card_fd = -1;
+}
+
+void host_card_set_latency(unsigned int cmd, unsigned int sector)
+{
+	cmd_ns = cmd;
+	sector_ns = sector;
+}
+
+void host_card_get_stats(struct host_card_stats *stats)
+{
+	stats->commands = nr_cmds;
+	stats->sectors = nr_sectors;
+	stats->busy_ns = busy_ns;
+}
+
+void host_card_reset_stats(void)
+{
+	nr_cmds = 0;
+	nr_sectors = 0;
+	busy_ns = 0;
+}
+
+int mmc_initialize(void)
+{
+	return (card_fd < 0) ? -1 : 0;
+}
+
+unsigned int mmc_bread(unsigned int start, unsigned int blkcnt, void *dest)
+{
+	ssize_t len = (ssize_t)blkcnt * SECTOR_SIZE;
+
+	nr_cmds++;
+	nr_sectors += blkcnt;
+	busy_ns += cmd_ns + (unsigned long long)blkcnt * sector_ns;
+
+	if (pread(card_fd, dest, len, (off_t)start * SECTOR_SIZE) != len)
+		return 0;
+
+	return blkcnt;
+}
+
+/* Pins and clocks are of no concern here */
+void at91_mci0_hw_init(void)
+{
+}
+
+/* The loader's messages go to stderr */
+int dbg_log(const char level, const char *fmt_str, ...)
+{
+	va_list ap;
+
+	if (host_card_quiet)
+		return 0;
+
+	va_start(ap, fmt_str);
+	vfprintf(stderr, fmt_str, ap);
+	va_end(ap);
+
+	return 0;
+}
@@ -0,0 +1,51 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __HOST_CARD_H__
+#define __HOST_CARD_H__
+
+/*
+ * Host side of the SD/MMC card: mmc_bread() and friends read from a disk
+ * image, so the loaders and file systems run unchanged on the host.
+ */
+struct host_card_stats {
+	unsigned int commands;		/* mmc_bread() calls */
+	unsigned int sectors;		/* Sectors transferred */
+	unsigned long long busy_ns;	/* Simulated time on the bus */
+};
+
+/* Set to silence dbg_log() */
+extern int host_card_quiet;
+
+extern int host_card_open(const char *path);
+extern void host_card_close(void);
+
+extern void host_card_set_latency(unsigned int cmd_ns, unsigned int sector_ns);
+extern void host_card_get_stats(struct host_card_stats *stats);
+extern void host_card_reset_stats(void);
+
+#endif /* #ifndef __HOST_CARD_H__ */
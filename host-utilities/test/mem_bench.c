@@ -0,0 +1,126 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * Host run of the DRAM benchmark kernels (driver/dram_kernels.c), timed
+ * with the host clock over windows from cache sized to DRAM sized. Gives
+ * a reference for the numbers dram_bench() prints on the board, and
+ * checks that the kernels do what they claim.
+ *
+ *   mem_bench [<window in KiB>]...
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "dram_kernels.h"
+
+static const unsigned int windows[] = { 16, 256, 4096, 65536 };
+
+static double now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int bench_window(unsigned int kib)
+{
+	unsigned int size = kib * 1024;
+	unsigned int words = size / sizeof(unsigned int);
+	unsigned int rounds = (64 << 20) / size + 1;
+	unsigned int *base;
+	unsigned int slots, sum, i;
+	double t, wr, rd, cp, lat;
+	void *last;
+	int ret = -1;
+
+	base = aligned_alloc(DRAM_CHASE_SLOT, size);
+	if (!base)
+		return -1;
+
+	t = now_ns();
+	for (i = 0; i < rounds; i++)
+		dram_write(base, words);
+	wr = (double)size * rounds / (now_ns() - t) * 1000;
+
+	t = now_ns();
+	for (i = 0; i < rounds; i++)
+		sum = dram_read(base, words);
+	rd = (double)size * rounds / (now_ns() - t) * 1000;
+
+	/* Each block of 8 words holds the number of words left */
+	for (i = words; i >= 8; i -= 8)
+		sum -= 8 * i;
+	if (sum) {
+		fprintf(stderr, "dram_read(): bad sum\n");
+		goto out;
+	}
+
+	t = now_ns();
+	for (i = 0; i < rounds; i++)
+		dram_copy(base + words / 2, base, words / 2);
+	cp = (double)size / 2 * rounds / (now_ns() - t) * 1000;
+
+	slots = dram_chase_setup(base, size);
+	t = now_ns();
+	last = dram_chase(base, slots);
+	lat = (now_ns() - t) / slots;
+
+	/* The cycle goes through every slot back to the first one */
+	if (last != base) {
+		fprintf(stderr, "dram_chase(): cycle does not close\n");
+		goto out;
+	}
+
+	printf("%8u %10.0f %10.0f %10.0f %10.1f\n", kib, wr, rd, cp, lat);
+	ret = 0;
+out:
+	free(base);
+	return ret;
+}
+
+int main(int argc, char **argv)
+{
+	unsigned int i;
+	int ret = 0;
+
+	printf("  window   write MB/s  read MB/s  copy MB/s  latency ns\n");
+
+	if (argc > 1) {
+		for (i = 1; i < argc; i++)
+			if (bench_window(strtoul(argv[i], NULL, 0)))
+				ret = 1;
+	} else {
+		for (i = 0; i < sizeof(windows) / sizeof(windows[0]); i++)
+			if (bench_window(windows[i]))
+				ret = 1;
+	}
+
+	return ret;
+}
@@ -0,0 +1,305 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/*
+ * Host test and benchmark of lib/string.c: every source and destination
+ * alignment against the host libc, then the throughput of the word/burst
+ * versions against the former byte loops.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* lib/string.c, built with renamed symbols */
+extern void *lib_memcpy(void *dst, const void *src, int cnt);
+extern void *lib_memset(void *dst, int val, int cnt);
+extern int lib_memcmp(const void *dst, const void *src, unsigned int cnt);
+
+#define ALIGNS		8
+#define MAX_LEN		200
+#define GUARD		16
+#define BUF_SIZE	(GUARD + ALIGNS + MAX_LEN + GUARD)
+
+static unsigned char src_buf[BUF_SIZE] __attribute__((aligned(64)));
+static unsigned char dst_buf[BUF_SIZE] __attribute__((aligned(64)));
+static unsigned char ref_buf[BUF_SIZE] __attribute__((aligned(64)));
+
+static int failures;
+
+static void fail(const char *what, int sa, int da, int len)
+{
+	if (failures++ < 20)
+		printf("FAIL %s: src align %d, dst align %d, len %d\n",
+			what, sa, da, len);
+}
+
+static void fill_random(unsigned char *buf, int len)
+{
+	int i;
+
+	for (i = 0; i < len; i++)
+		buf[i] = rand();
+}
+
+static void test_memcpy(void)
+{
+	int sa, da, len;
+	unsigned char *src, *dst;
+
+	for (sa = 0; sa < ALIGNS; sa++)
+	for (da = 0; da < ALIGNS; da++)
+	for (len = 0; len <= MAX_LEN; len++) {
+		fill_random(src_buf, BUF_SIZE);
+		fill_random(dst_buf, BUF_SIZE);
+		memcpy(ref_buf, dst_buf, BUF_SIZE);
+
+		src = src_buf + GUARD + sa;
+		dst = dst_buf + GUARD + da;
+		memcpy(ref_buf + GUARD + da, src, len);
+
+		if (lib_memcpy(dst, src, len) != dst)
+			fail("memcpy return", sa, da, len);
+		if (memcmp(dst_buf, ref_buf, BUF_SIZE))
+			fail("memcpy data", sa, da, len);
+	}
+}
+
+static void test_memset(void)
+{
+	static const int vals[] = { 0, 0x5a, 0xff, 0x1a5, -1 };
+	int da, len, v;
+	unsigned char *dst;
+
+	for (v = 0; v < sizeof(vals) / sizeof(vals[0]); v++)
+	for (da = 0; da < ALIGNS; da++)
+	for (len = 0; len <= MAX_LEN; len++) {
+		fill_random(dst_buf, BUF_SIZE);
+		memcpy(ref_buf, dst_buf, BUF_SIZE);
+
+		dst = dst_buf + GUARD + da;
+		memset(ref_buf + GUARD + da, vals[v], len);
+
+		if (lib_memset(dst, vals[v], len) != dst)
+			fail("memset return", 0, da, len);
+		if (memcmp(dst_buf, ref_buf, BUF_SIZE))
+			fail("memset data", 0, da, len);
+	}
+}
+
+static int sign(int r)
+{
+	return (r > 0) - (r < 0);
+}
+
+static void test_memcmp(void)
+{
+	int sa, da, len, pos;
+	unsigned char *a, *b;
+
+	for (sa = 0; sa < ALIGNS; sa++)
+	for (da = 0; da < ALIGNS; da++)
+	for (len = 0; len <= MAX_LEN; len++) {
+		fill_random(src_buf, BUF_SIZE);
+		a = src_buf + GUARD + sa;
+		b = dst_buf + GUARD + da;
+		memcpy(b, a, len);
+
+		if (lib_memcmp(a, b, len) != 0)
+			fail("memcmp equal", sa, da, len);
+
+		/* one differing byte at each position, both signs */
+		for (pos = 0; pos < len; pos++) {
+			b[pos] = a[pos] ^ 0x80;
+			if (sign(lib_memcmp(a, b, len)) != sign(memcmp(a, b, len))
+			 || sign(lib_memcmp(b, a, len)) != sign(memcmp(b, a, len)))
+				fail("memcmp order", sa, da, len);
+			b[pos] = a[pos];
+		}
+	}
+}
+
+/* The byte loops lib/string.c used to carry, as the reference */
+static void *old_memcpy(void *dst, const void *src, int cnt)
+{
+	volatile char *d = (char *)dst;
+	const char *s = (const char *)src;
+
+	while (cnt--)
+		*d++ = *s++;
+
+	return (void *)d;
+}
+
+static void *old_memset(void *dst, int val, int cnt)
+{
+	volatile char *d = (char *)dst;
+
+	while (cnt--)
+		*d++ = (char)val;
+
+	return (void *)d;
+}
+
+static int old_memcmp(const void *dst, const void *src, unsigned int cnt)
+{
+	volatile const char *d = (const char *)dst;
+	const char *s = (const char *)src;
+	int r = 0;
+
+	while (cnt-- && (r = *d++ - *s++) == 0) ;
+
+	return r;
+}
+
+#define BENCH_SIZE	(1024 * 1024)
+#define BENCH_BYTES	(256 * 1024 * 1024)
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static double rate(double t)
+{
+	return BENCH_BYTES / t / (1024 * 1024);
+}
+
+static void bench(void)
+{
+	unsigned char *src = malloc(BENCH_SIZE + 64);
+	unsigned char *dst = malloc(BENCH_SIZE + 64);
+	static const int offsets[][2] = { { 0, 0 }, { 1, 1 }, { 0, 1 }, { 3, 2 } };
+	double t;
+	int i, n, sa, da;
+	volatile int r = 0;
+
+	memset(src, 0x5a, BENCH_SIZE + 64);
+	memset(dst, 0x5a, BENCH_SIZE + 64);
+
+	printf("%-10s %-8s %12s %12s %12s\n",
+		"function", "src/dst", "old MB/s", "new MB/s", "libc MB/s");
+
+	for (i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++) {
+		double r_old, r_new, r_libc;
+
+		sa = offsets[i][0];
+		da = offsets[i][1];
+
+		t = now();
+		for (n = 0; n < BENCH_BYTES / BENCH_SIZE; n++)
+			old_memcpy(dst + da, src + sa, BENCH_SIZE);
+		r_old = rate(now() - t);
+
+		t = now();
+		for (n = 0; n < BENCH_BYTES / BENCH_SIZE; n++)
+			lib_memcpy(dst + da, src + sa, BENCH_SIZE);
+		r_new = rate(now() - t);
+
+		t = now();
+		for (n = 0; n < BENCH_BYTES / BENCH_SIZE; n++)
+			memcpy(dst + da, src + sa, BENCH_SIZE);
+		r_libc = rate(now() - t);
+
+		printf("%-10s %d/%-6d %12.0f %12.0f %12.0f\n",
+			"memcpy", sa, da, r_old, r_new, r_libc);
+	}
+
+	for (da = 0; da < 2; da++) {
+		double r_old, r_new, r_libc;
+
+		t = now();
+		for (n = 0; n < BENCH_BYTES / BENCH_SIZE; n++)
+			old_memset(dst + da, n, BENCH_SIZE);
+		r_old = rate(now() - t);
+
+		t = now();
+		for (n = 0; n < BENCH_BYTES / BENCH_SIZE; n++)
+			lib_memset(dst + da, n, BENCH_SIZE);
+		r_new = rate(now() - t);
+
+		t = now();
+		for (n = 0; n < BENCH_BYTES / BENCH_SIZE; n++)
+			memset(dst + da, n, BENCH_SIZE);
+		r_libc = rate(now() - t);
+
+		printf("%-10s -/%-6d %12.0f %12.0f %12.0f\n",
+			"memset", da, r_old, r_new, r_libc);
+	}
+
+	memcpy(dst, src, BENCH_SIZE + 64);
+	for (i = 0; i < 2; i++) {
+		double r_old, r_new, r_libc;
+
+		sa = da = i;
+
+		t = now();
+		for (n = 0; n < BENCH_BYTES / BENCH_SIZE; n++)
+			r += old_memcmp(dst + da, src + sa, BENCH_SIZE);
+		r_old = rate(now() - t);
+
+		t = now();
+		for (n = 0; n < BENCH_BYTES / BENCH_SIZE; n++)
+			r += lib_memcmp(dst + da, src + sa, BENCH_SIZE);
+		r_new = rate(now() - t);
+
+		t = now();
+		for (n = 0; n < BENCH_BYTES / BENCH_SIZE; n++)
+			r += memcmp(dst + da, src + sa, BENCH_SIZE);
+		r_libc = rate(now() - t);
+
+		printf("%-10s %d/%-6d %12.0f %12.0f %12.0f\n",
+			"memcmp", sa, da, r_old, r_new, r_libc);
+	}
+
+	free(src);
+	free(dst);
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc > 1 && !strcmp(argv[1], "-b")) {
+		bench();
+		return 0;
+	}
+
+	srand(1);
+	test_memcpy();
+	test_memset();
+	test_memcmp();
+
+	if (failures) {
+		printf("string: %d failures\n", failures);
+		return 1;
+	}
+	printf("string: memcpy/memset/memcmp ok, alignments 0..%d, lengths 0..%d\n",
+		ALIGNS - 1, MAX_LEN);
+	return 0;
+}
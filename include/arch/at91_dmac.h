@@ -0,0 +1,123 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __AT91_DMAC_H__
+#define __AT91_DMAC_H__
+
+/* *** Register offset in AT91S_DMAC structure ***/
+#define DMAC_GCFG	0x00	/* Global Configuration Register */
+#define DMAC_EN		0x04	/* Enable Register */
+#define DMAC_SREQ	0x08	/* Software Single Request Register */
+#define DMAC_CREQ	0x0C	/* Software Chunk Transfer Request Register */
+#define DMAC_LAST	0x10	/* Software Last Transfer Flag Register */
+#define DMAC_EBCIER	0x18	/* Buffer Transfer Completed Interrupt Enable */
+#define DMAC_EBCIDR	0x1C	/* Buffer Transfer Completed Interrupt Disable */
+#define DMAC_EBCIMR	0x20	/* Buffer Transfer Completed Interrupt Mask */
+#define DMAC_EBCISR	0x24	/* Buffer Transfer Completed Interrupt Status */
+#define DMAC_CHER	0x28	/* Channel Handler Enable Register */
+#define DMAC_CHDR	0x2C	/* Channel Handler Disable Register */
+#define DMAC_CHSR	0x30	/* Channel Handler Status Register */
+
+/* Channel registers */
+#define DMAC_CH_OFFSET(ch)	(0x3C + (ch) * 0x28)
+#define DMAC_SADDR(ch)		(DMAC_CH_OFFSET(ch) + 0x00)	/* Source Address */
+#define DMAC_DADDR(ch)		(DMAC_CH_OFFSET(ch) + 0x04)	/* Destination Address */
+#define DMAC_DSCR(ch)		(DMAC_CH_OFFSET(ch) + 0x08)	/* Descriptor Address */
+#define DMAC_CTRLA(ch)		(DMAC_CH_OFFSET(ch) + 0x0C)	/* Control A */
+#define DMAC_CTRLB(ch)		(DMAC_CH_OFFSET(ch) + 0x10)	/* Control B */
+#define DMAC_CFG(ch)		(DMAC_CH_OFFSET(ch) + 0x14)	/* Configuration */
+
+/* -------- DMAC_GCFG : (DMAC Offset: 0x00) Global Configuration --------*/
+#define AT91C_DMAC_ARB_CFG_FIXED	(0x0UL << 4)
+#define AT91C_DMAC_ARB_CFG_ROUND_ROBIN	(0x1UL << 4)
+
+/* -------- DMAC_EN : (DMAC Offset: 0x04) Enable Register --------*/
+#define AT91C_DMAC_ENABLE	(0x1UL << 0)
+
+/* -------- DMAC_EBCIxR : (DMAC Offset: 0x18) Interrupt Registers --------*/
+#define AT91C_DMAC_BTC(ch)	(0x1UL << (ch))
+#define AT91C_DMAC_CBTC(ch)	(0x1UL << (8 + (ch)))
+#define AT91C_DMAC_ERR(ch)	(0x1UL << (16 + (ch)))
+
+/* -------- DMAC_CHER : (DMAC Offset: 0x28) Channel Handler Enable --------*/
+#define AT91C_DMAC_ENA(ch)	(0x1UL << (ch))
+#define AT91C_DMAC_SUSP(ch)	(0x1UL << (8 + (ch)))
+#define AT91C_DMAC_KEEP(ch)	(0x1UL << (24 + (ch)))
+
+/* -------- DMAC_CHDR : (DMAC Offset: 0x2C) Channel Handler Disable --------*/
+#define AT91C_DMAC_DIS(ch)	(0x1UL << (ch))
+#define AT91C_DMAC_RES(ch)	(0x1UL << (8 + (ch)))
+
+/* -------- DMAC_CHSR : (DMAC Offset: 0x30) Channel Handler Status --------*/
+#define AT91C_DMAC_EMPT(ch)	(0x1UL << (16 + (ch)))
+#define AT91C_DMAC_STAL(ch)	(0x1UL << (24 + (ch)))
+
+/* -------- DMAC_CTRLAx : Channel Control A --------*/
+#define AT91C_DMAC_BTSIZE	(0xFFFFUL << 0)
+#define AT91C_DMAC_SCSIZE_1	(0x0UL << 16)
+#define AT91C_DMAC_SCSIZE_4	(0x1UL << 16)
+#define AT91C_DMAC_SCSIZE_8	(0x2UL << 16)
+#define AT91C_DMAC_SCSIZE_16	(0x3UL << 16)
+#define AT91C_DMAC_DCSIZE_1	(0x0UL << 20)
+#define AT91C_DMAC_DCSIZE_4	(0x1UL << 20)
+#define AT91C_DMAC_DCSIZE_8	(0x2UL << 20)
+#define AT91C_DMAC_DCSIZE_16	(0x3UL << 20)
+#define AT91C_DMAC_SRC_WIDTH(x)	(((x) & 0x3) << 24)
+#define AT91C_DMAC_DST_WIDTH(x)	(((x) & 0x3) << 28)
+#define AT91C_DMAC_DONE		(0x1UL << 31)
+
+/* -------- DMAC_CTRLBx : Channel Control B --------*/
+#define AT91C_DMAC_SIF(x)	(((x) & 0x3) << 0)
+#define AT91C_DMAC_DIF(x)	(((x) & 0x3) << 4)
+#define AT91C_DMAC_SRC_DSCR	(0x1UL << 16)	/* 1: no descriptor fetch */
+#define AT91C_DMAC_DST_DSCR	(0x1UL << 20)	/* 1: no descriptor fetch */
+#define AT91C_DMAC_FC_MEM2MEM	(0x0UL << 21)
+#define AT91C_DMAC_FC_MEM2PER	(0x1UL << 21)
+#define AT91C_DMAC_FC_PER2MEM	(0x2UL << 21)
+#define AT91C_DMAC_FC_PER2PER	(0x3UL << 21)
+#define AT91C_DMAC_SRC_INCR	(0x0UL << 24)
+#define AT91C_DMAC_SRC_FIXED	(0x2UL << 24)
+#define AT91C_DMAC_DST_INCR	(0x0UL << 28)
+#define AT91C_DMAC_DST_FIXED	(0x2UL << 28)
+#define AT91C_DMAC_IEN		(0x1UL << 30)
+#define AT91C_DMAC_AUTO		(0x1UL << 31)
+
+/* -------- DMAC_CFGx : Channel Configuration --------*/
+#define AT91C_DMAC_SRC_PER(x)	((((x) & 0xF) << 0) | ((((x) >> 4) & 0x3) << 10))
+#define AT91C_DMAC_DST_PER(x)	((((x) & 0xF) << 4) | ((((x) >> 4) & 0x3) << 14))
+#define AT91C_DMAC_SRC_REP	(0x1UL << 8)
+#define AT91C_DMAC_SRC_H2SEL	(0x1UL << 9)
+#define AT91C_DMAC_DST_REP	(0x1UL << 12)
+#define AT91C_DMAC_DST_H2SEL	(0x1UL << 13)
+#define AT91C_DMAC_SOD		(0x1UL << 16)
+#define AT91C_DMAC_LOCK_IF	(0x1UL << 20)
+#define AT91C_DMAC_AHB_PROT(x)	(((x) & 0x7) << 24)
+#define AT91C_DMAC_FIFOCFG_ALAP	(0x0UL << 28)
+#define AT91C_DMAC_FIFOCFG_HALF	(0x1UL << 28)
+#define AT91C_DMAC_FIFOCFG_ASAP	(0x2UL << 28)
+
+#endif /* #ifndef __AT91_DMAC_H__ */
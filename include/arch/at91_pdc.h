@@ -0,0 +1,52 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __AT91_PDC_H__
+#define __AT91_PDC_H__
+
+/* *** Register offset of the PDC, relative to the peripheral base ***/
+#define PERIPH_RPR	0x100	/* Receive Pointer Register */
+#define PERIPH_RCR	0x104	/* Receive Counter Register */
+#define PERIPH_TPR	0x108	/* Transmit Pointer Register */
+#define PERIPH_TCR	0x10C	/* Transmit Counter Register */
+#define PERIPH_RNPR	0x110	/* Receive Next Pointer Register */
+#define PERIPH_RNCR	0x114	/* Receive Next Counter Register */
+#define PERIPH_TNPR	0x118	/* Transmit Next Pointer Register */
+#define PERIPH_TNCR	0x11C	/* Transmit Next Counter Register */
+#define PERIPH_PTCR	0x120	/* PDC Transfer Control Register */
+#define PERIPH_PTSR	0x124	/* PDC Transfer Status Register */
+
+/* -------- PDC_PTCR : (PDC Offset: 0x20) PDC Transfer Control Register --------*/
+#define AT91C_PDC_RXTEN		(0x1UL << 0)	/* Receiver Transfer Enable */
+#define AT91C_PDC_RXTDIS	(0x1UL << 1)	/* Receiver Transfer Disable */
+#define AT91C_PDC_TXTEN		(0x1UL << 8)	/* Transmitter Transfer Enable */
+#define AT91C_PDC_TXTDIS	(0x1UL << 9)	/* Transmitter Transfer Disable */
+
+/* Maximum value of the counter registers */
+#define AT91C_PDC_MAX_COUNT	0xFFFF
+
+#endif /* #ifndef __AT91_PDC_H__ */
@@ -30,6 +30,8 @@
 
 extern int load_dataflash(struct image_info *img_info);
 
+extern int dataflash_probe(void);
+
 extern int dataflash_page0_erase(void);
 
 #endif
@@ -34,6 +34,7 @@
 
 extern void dbgu_init(unsigned int);
 extern void dbgu_print(const char *ptr);
+extern void dbgu_flush(void);
 extern char dbgu_getc(void);
 
 #endif /* #ifndef __DBGU_H__ */
@@ -41,4 +41,10 @@ extern int ddram_initialize(unsigned int base_address,
 		unsigned int ram_address,
 		struct ddramc_register *ddramc_config);
 
+struct dram_timing;
+
+extern int ddramc_timing(struct ddramc_register *ddramc_config,
+		const struct dram_timing *timing,
+		unsigned int mck);
+
 #endif /* #ifndef __DDRAMC_H__ */
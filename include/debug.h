@@ -57,7 +57,30 @@
 #define DEBUG_LOUD        2
 #define DEBUG_VERY_LOUD   4
 
-#ifdef CONFIG_DEBUG
+#if defined(CONFIG_DEBUG) && defined(CONFIG_DEBUG_TRACE)
+/*
+ * Binary trace: the format strings go to the .dbg_fmt section, which
+ * is not loaded, and the offset of the string in it is the message ID.
+ * Only the ID and the raw arguments are recorded, scripts/dbgtrace.py
+ * turns them back into text with the strings from the elf file.
+ */
+#define DBG_NARGS(...)	DBG_NARGS_(_, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define DBG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, n, ...)	n
+
+#define dbg_log(level, fmt_str, ...)					\
+	({								\
+		static const char __dbg_fmt[]				\
+			__attribute__((section(".dbg_fmt"))) = fmt_str;	\
+		int __dbg_ret = 0;					\
+		if ((level) <= BOOTSTRAP_DEBUG_LEVEL)			\
+			__dbg_ret = dbg_trace(__dbg_fmt,		\
+				DBG_NARGS(__VA_ARGS__), ##__VA_ARGS__);	\
+		__dbg_ret;						\
+	})
+
+extern int dbg_trace(const char *fmt_id, unsigned int nargs, ...);
+extern void dbg_trace_flush(void);
+#elif defined(CONFIG_DEBUG)
 extern int dbg_log(const char level, const char *fmt_str, ...);
 #else
 #define dbg_log(...)
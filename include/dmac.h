@@ -0,0 +1,83 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __DMAC_H__
+#define __DMAC_H__
+
+/* Channels used by the bootstrap */
+#define DMAC_CH_MEMCPY		0
+#define DMAC_CH_MCI		1
+#define DMAC_CH_SPI_RX		2
+#define DMAC_CH_SPI_TX		3
+#define DMAC_NR_CHANNELS	4
+
+/* Transfer width */
+#define DMAC_WIDTH_BYTE		0
+#define DMAC_WIDTH_HALFWORD	1
+#define DMAC_WIDTH_WORD		2
+
+/* Descriptors available to a channel, each moves up to BTSIZE items */
+#define DMAC_DESC_PER_CHANNEL	8
+#define DMAC_MAX_BTSIZE		0xFFFF
+#define DMAC_MAX_XFER_LEN(width)	\
+	((DMAC_MAX_BTSIZE << (width)) * DMAC_DESC_PER_CHANNEL)
+
+/* Transfer type */
+#define DMAC_MEM_TO_MEM		0
+#define DMAC_MEM_TO_PER		1
+#define DMAC_PER_TO_MEM		2
+
+/*
+ * Linked list item, fetched by the controller from memory.
+ * Must be word aligned.
+ */
+struct dmac_desc {
+	unsigned int	saddr;
+	unsigned int	daddr;
+	unsigned int	ctrla;
+	unsigned int	ctrlb;
+	unsigned int	dscr;
+};
+
+struct dmac_xfer {
+	unsigned int	src;		/* source address */
+	unsigned int	dst;		/* destination address */
+	unsigned int	len;		/* length in bytes */
+	unsigned int	width;		/* DMAC_WIDTH_xxx */
+	unsigned int	type;		/* DMAC_xxx_TO_xxx */
+	unsigned int	per_id;		/* hardware handshaking interface */
+};
+
+extern int dmac_init(void);
+extern int dmac_request(unsigned int ch);
+extern int dmac_start(unsigned int ch, const struct dmac_xfer *xfer);
+extern int dmac_is_done(unsigned int ch);
+extern int dmac_wait(unsigned int ch);
+extern void dmac_stop(unsigned int ch);
+extern int dmac_memcpy(void *dst, const void *src, unsigned int len);
+
+#endif /* #ifndef __DMAC_H__ */
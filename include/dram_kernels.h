@@ -0,0 +1,53 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __DRAM_KERNELS_H__
+#define __DRAM_KERNELS_H__
+
+/*
+ * Memory access kernels of the DRAM benchmark. They are plain C without
+ * any hardware access, so the host benchmark (host-utilities/test) runs
+ * the very same code; the callers do the timing.
+ */
+
+/* Bytes per slot of the latency chase, one pointer each */
+#define DRAM_CHASE_SLOT		32
+
+extern void dram_write(volatile unsigned int *p, unsigned int words);
+
+extern unsigned int dram_read(const volatile unsigned int *p,
+				unsigned int words);
+
+extern void dram_copy(volatile unsigned int *dst,
+			const volatile unsigned int *src,
+			unsigned int words);
+
+extern unsigned int dram_chase_setup(void *base, unsigned int size);
+
+extern void *dram_chase(void *base, unsigned int slots);
+
+#endif /* #ifndef __DRAM_KERNELS_H__ */
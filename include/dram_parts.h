@@ -0,0 +1,70 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __DRAM_PARTS_H__
+#define __DRAM_PARTS_H__
+
+/*
+ * Datasheet timings of the memories found on the boards, to initialize
+ * a struct dram_timing (see dram_timing.h).
+ */
+
+/* Micron MT47H64M16HR-3, DDR2 */
+#define DRAM_MT47H64M16HR_3	{	\
+	.tras	= 45,			\
+	.trcd	= 15,			\
+	.twr	= 15,			\
+	.trc	= 60,			\
+	.trp	= 15,			\
+	.trpa	= 20,			\
+	.trrd	= 10,			\
+	.trfc	= 135,			\
+	.txsnr	= 142,			\
+	.tfaw	= 50,			\
+	.trefi	= 7800,			\
+					\
+	.twtr	= 2,			\
+	.tmrd	= 2,			\
+	.trtp	= 2,			\
+	.txp	= 2,			\
+	.txsrd	= 200,			\
+	.txard	= 2,			\
+	.txards	= 7,			\
+}
+
+/* Micron MT48LC16M16A2-75, SDR SDRAM */
+#define DRAM_MT48LC16M16A2_75	{	\
+	.tras	= 44,			\
+	.trcd	= 20,			\
+	.twr	= 15,			\
+	.trc	= 66,			\
+	.trp	= 20,			\
+	.txsnr	= 75,			\
+	.trefi	= 7812,			\
+}
+
+#endif /* #ifndef __DRAM_PARTS_H__ */
@@ -0,0 +1,85 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __DRAM_TIMING_H__
+#define __DRAM_TIMING_H__
+
+/*
+ * Memory timings as found in the datasheet. The controller registers are
+ * derived from them for a given MCK, see ddramc_timing()/sdramc_timing().
+ */
+struct dram_timing {
+	/* in ns, half ns values are rounded up */
+	unsigned int tras;	/* active to precharge */
+	unsigned int trcd;	/* active to read/write */
+	unsigned int twr;	/* write recovery */
+	unsigned int trc;	/* active to active, same bank */
+	unsigned int trp;	/* precharge period */
+	unsigned int trpa;	/* precharge all period */
+	unsigned int trrd;	/* active to active, different banks */
+	unsigned int trfc;	/* refresh to active */
+	unsigned int txsnr;	/* exit self refresh to non read command */
+	unsigned int tfaw;	/* four active window */
+	unsigned int trefi;	/* average refresh interval */
+
+	/* in clock cycles */
+	unsigned int twtr;
+	unsigned int tmrd;
+	unsigned int trtp;
+	unsigned int txp;
+	unsigned int txsrd;
+	unsigned int txard;
+	unsigned int txards;
+};
+
+/*
+ * Rounding the MCK up to the next MHz for the timings and down for the
+ * refresh count keeps both on the safe side. Both macros fold to constants
+ * when ns and mck are constants.
+ */
+#define DRAM_NS_TO_CYCLES(ns, mck)	\
+	(((ns) * (((mck) + 999999) / 1000000) + 999) / 1000)
+
+#define DRAM_REFRESH_COUNT(ns, mck)	\
+	(((ns) * ((mck) / 1000000)) / 1000)
+
+/* Place a cycle count in a register field, saturating if it does not fit */
+static inline unsigned int dram_field(unsigned int cycles,
+				unsigned int mask,
+				int *saturated)
+{
+	unsigned int lsb = mask & (~mask + 1);
+
+	if (cycles > mask / lsb) {
+		cycles = mask / lsb;
+		*saturated = 1;
+	}
+
+	return cycles * lsb;
+}
+
+#endif /* #ifndef __DRAM_TIMING_H__ */
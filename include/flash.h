@@ -26,7 +26,16 @@
 #ifndef __NORFLASH_H__
 #define __NORFLASH_H__
 
-#define AT91_NORFLASH_BASE	AT91C_EBI_CS0
+/* Boards with several EBIs name the chip select and SMC of the NOR flash */
+#ifndef CONFIG_SYS_NOR_BASE
+#define CONFIG_SYS_NOR_BASE	AT91C_BASE_CS0
+#endif
+#ifndef CONFIG_SYS_NOR_SMC
+#define CONFIG_SYS_NOR_SMC	AT91C_BASE_SMC
+#endif
+
+#define AT91_NORFLASH_BASE	CONFIG_SYS_NOR_BASE
+#define AT91_NORFLASH_SMC	CONFIG_SYS_NOR_SMC
 
 /* SMC Chip select 0 timings */
 #define AT91C_FLASH_NWE_SETUP           (4 << 0)
@@ -44,7 +53,7 @@
 
 void norflash_hw_init(void);
 
-int load_norflash(unsigned int img_addr, unsigned int img_size,
-                  unsigned int img_dest);
+extern int load_norflash(struct image_info *img_info);
+extern int norflash_xip_image(struct image_info *img_info);
 
 #endif	/* #ifndef __NORFLASH_H__ */
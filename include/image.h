@@ -0,0 +1,53 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __IMAGE_H__
+#define __IMAGE_H__
+
+#define IH_MAGIC	0x27051956	/* Image Magic Number		*/
+#define IH_NMLEN	32		/* Image Name Length		*/
+
+/*
+ * Legacy format image header,
+ * all data in network byte order (aka natural aka bigendian).
+ */
+typedef struct image_header {
+	unsigned int	ih_magic;	/* Image Header Magic Number	*/
+	unsigned int	ih_hcrc;	/* Image Header CRC Checksum	*/
+	unsigned int	ih_time;	/* Image Creation Timestamp	*/
+	unsigned int	ih_size;	/* Image Data Size		*/
+	unsigned int	ih_load;	/* Data	 Load  Address		*/
+	unsigned int	ih_ep;		/* Entry Point Address		*/
+	unsigned int	ih_dcrc;	/* Image Data CRC Checksum	*/
+	unsigned char	ih_os;		/* Operating System		*/
+	unsigned char	ih_arch;	/* CPU architecture		*/
+	unsigned char	ih_type;	/* Image Type			*/
+	unsigned char	ih_comp;	/* Compression Type		*/
+	unsigned char	ih_name[IH_NMLEN];	/* Image Name		*/
+} image_header_t;
+
+#endif /* #ifndef __IMAGE_H__ */
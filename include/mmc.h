@@ -59,6 +59,7 @@
 //#define MMC_MODE_SPI		0x400
 
 #define SD_DATA_4BIT		0x00040000
+#define SD_SCR_CMD23_SUPPORT	0x00000002	/* SCR bit 33 */
 
 #define IS_SD(x) (x->version & SD_VERSION_SD)
 
@@ -112,6 +113,7 @@
 #define EXT_CSD_CARD_TYPE	196	/* RO */
 #define EXT_CSD_REV		192	/* RO */
 #define EXT_CSD_SEC_CNT		212	/* RO, 4 bytes */
+#define EXT_CSD_BOOT_MULT	226	/* RO */
 
 /*
  * EXT_CSD field definitions
@@ -124,6 +126,14 @@
 #define EXT_CSD_CARD_TYPE_26	(1 << 0)	/* Card can run at 26MHz */
 #define EXT_CSD_CARD_TYPE_52	(1 << 1)	/* Card can run at 52MHz */
 
+#define EXT_CSD_PART_ACCESS_MASK	0x7	/* PARTITION_ACCESS */
+#define EXT_CSD_PART_ACCESS_USER	0	/* User data area */
+#define EXT_CSD_PART_ACCESS_BOOT1	1	/* Boot partition 1 */
+#define EXT_CSD_PART_ACCESS_BOOT2	2	/* Boot partition 2 */
+
+/* BOOT_SIZE_MULT is in units of 128KiB, i.e. 256 blocks */
+#define EXT_CSD_BOOT_MULT_BLOCKS	256
+
 #define EXT_CSD_BUS_WIDTH_1	0	/* Card is in 1 bit mode */
 #define EXT_CSD_BUS_WIDTH_4	1	/* Card is in 4 bit mode */
 #define EXT_CSD_BUS_WIDTH_8	2	/* Card is in 8 bit mode */
@@ -140,6 +150,10 @@ struct mmc {
 	unsigned int cid[4];
 	unsigned short rca;
 	unsigned int read_bl_len;
+	int blocklen_set;	/* SET_BLOCKLEN already sent */
+	int has_cmd23;		/* SET_BLOCK_COUNT supported */
+	unsigned char part_config;	/* EXT_CSD PARTITION_CONFIG */
+	unsigned int boot_blocks;	/* size of each boot partition */
 };
 
 #endif /* #ifndef __MMC_H__ */
@@ -30,4 +30,6 @@
 
 extern int load_nandflash(struct image_info *img_info);
 
+extern int nandflash_probe(void);
+
 #endif /* #ifndef __NANDFLASH_H__ */
@@ -34,4 +34,11 @@ extern unsigned int wait_interval_timer(unsigned int time, unsigned int timer);
 
 extern int wait_timer(unsigned int time);
 
+extern unsigned int pit_get_ticks(void);
+extern unsigned int pit_us_to_ticks(unsigned int time);
+extern int pit_ticks_passed(unsigned int ticks);
+
+extern void pit_budget_start(unsigned int time);
+extern int pit_budget_expired(void);
+
 #endif /* #ifndef __PIT_TIMER_H__ */
@@ -30,4 +30,6 @@
 
 extern int load_sdcard(struct image_info *img_info);
 
+extern int sdcard_probe(void);
+
 #endif /* #ifndef __SDCARD_H__ */
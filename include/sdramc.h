@@ -39,4 +39,12 @@ struct sdramc_register {
 int sdramc_initialize(struct sdramc_register *sdramc_config,
 			unsigned int sdram_address);
 
+void sdramc_set_refresh(unsigned int tr);
+
+struct dram_timing;
+
+int sdramc_timing(struct sdramc_register *sdramc_config,
+			const struct dram_timing *timing,
+			unsigned int mck);
+
 #endif	/* #ifndef __SDRAMC_H__ */
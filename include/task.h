@@ -0,0 +1,55 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2006, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __TASK_H__
+#define __TASK_H__
+
+#define TASK_DONE	0
+#define TASK_AGAIN	1
+
+/*
+ * Run to completion tasks: run() does one step of the work without
+ * blocking, and returns TASK_AGAIN until it is done. A task which has
+ * to wait for a device calls task_sleep() before returning.
+ */
+struct task {
+	const char	*name;
+	int		(*run)(struct task *task);
+	unsigned int	state;		/* private to the task */
+	unsigned int	wake;		/* ticks */
+	int		result;
+	int		active;
+	struct task	*next;
+};
+
+extern void task_start(struct task *task);
+extern void task_sleep(struct task *task, unsigned int time);
+extern void task_yield(void);
+extern int task_wait(struct task *task);
+extern void task_wait_all(void);
+
+#endif /* #ifndef __TASK_H__ */
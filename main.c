@@ -29,11 +29,15 @@
 #include "hardware.h"
 #include "board.h"
 #include "debug.h"
+#include "dbgu.h"
 #include "slowclk.h"
 #include "dataflash.h"
 #include "nandflash.h"
 #include "sdcard.h"
 #include "flash.h"
+#include "boot_media.h"
+#include "task.h"
+#include "dram_bench.h"
 
 extern int load_kernel(struct image_info *img_info);
 
@@ -45,6 +49,8 @@ static int init_loadfunction(void)
 {
 #if defined(CONFIG_LOAD_LINUX)
 	load_image = &load_kernel;
+#elif defined(CONFIG_BOOT_CHAIN)
+	load_image = &load_boot_media;
 #else
 #if defined (CONFIG_DATAFLASH)
 	load_image = &load_dataflash;
@@ -52,6 +58,8 @@ static int init_loadfunction(void)
 	load_image = &load_nandflash;
 #elif defined(CONFIG_SDCARD)
 	load_image = &load_sdcard;
+#elif defined(CONFIG_FLASH)
+	load_image = &load_norflash;
 #else
 #error "No booting media specified!"
 #endif
@@ -59,6 +67,16 @@ static int init_loadfunction(void)
 	return 0;
 }
 
+static void console_flush(void)
+{
+#ifdef CONFIG_DEBUG_TRACE
+	dbg_trace_flush();
+#endif
+#ifdef CONFIG_DBGU_ASYNC
+	dbgu_flush();
+#endif
+}
+
 static void display_banner (void)
 {
 	dbg_log(1, "\n\nAT91Bootstrap %s\n\n\r",
@@ -71,7 +89,11 @@ int main(void)
 	int ret;
 
 	image_info.dest = (unsigned char *)JUMP_ADDR;
-#if defined (CONFIG_DATAFLASH) || defined(CONFIG_NANDFLASH)
+#if defined(CONFIG_BOOT_CHAIN)
+	/* The offset depends on the medium, it is set by the boot chain */
+	image_info.length = IMG_SIZE;
+#elif defined (CONFIG_DATAFLASH) || defined(CONFIG_NANDFLASH) \
+	|| defined(CONFIG_SDCARD_RAW) || defined(CONFIG_FLASH)
 	image_info.offset = IMG_ADDRESS;
 	image_info.length = IMG_SIZE;
 #endif
@@ -85,6 +107,10 @@ int main(void)
 
 	display_banner();
 
+#ifdef CONFIG_DRAM_BENCH
+	dram_bench();
+#endif
+
 	init_loadfunction();
 
 	dbg_log(1, "Downloading image...\n\r");
@@ -95,13 +121,28 @@ int main(void)
 	}
 	if (ret == -1) {
 		dbg_log(1, "Failed to load image\n\r");
+		console_flush();
 		while(1);
 	}
 	if (ret == -2) {
 		dbg_log(1, "Success to recovery\n\r");
+		console_flush();
 		while (1);
 	}
 
+#ifdef CONFIG_BOOT_TASKS
+	/* Do not leave a device half way through its setup */
+	task_wait_all();
+#endif
+
+#ifdef CONFIG_CLOCK_BOOST
+	/* The copy is done, hand over at the production clock */
+	hw_clock_handoff();
+#endif
+
+	/* The next stage owns the DBGU */
+	console_flush();
+
 #ifdef CONFIG_SCLK
 	slowclk_switch_osc32();
 #endif
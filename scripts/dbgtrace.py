@@ -0,0 +1,122 @@
+#!/usr/bin/env python
+#
+# Print the binary trace of a CONFIG_DEBUG_TRACE build as text.
+#
+# usage: dbgtrace.py <at91bootstrap elf> <trace>
+#
+# The trace is either a memory dump taken at CONFIG_DEBUG_TRACE_ADDR, or
+# a console capture holding the "#T" lines of CONFIG_DEBUG_TRACE_DUMP.
+# The format strings are read from the .dbg_fmt section of the elf file,
+# "%s" arguments from its loaded sections.
+
+import re, struct, sys
+
+TRACE_MAGIC = 0x45435254
+
+def read_sections(path):
+	fd = open(path, "rb")
+	elf = fd.read()
+	fd.close()
+
+	if elf[0:4] != b"\x7fELF":
+		sys.exit("%s: not an elf file" % path)
+
+	is64 = elf[4:5] == b"\x02"
+	end = "<" if elf[5:6] == b"\x01" else ">"
+
+	if is64:
+		shoff, = struct.unpack(end + "Q", elf[0x28:0x30])
+		shentsize, shnum, shstrndx = struct.unpack(end + "HHH", elf[0x3a:0x40])
+		shdr = end + "IIQQQQIIQQ"
+	else:
+		shoff, = struct.unpack(end + "I", elf[0x20:0x24])
+		shentsize, shnum, shstrndx = struct.unpack(end + "HHH", elf[0x2e:0x34])
+		shdr = end + "IIIIIIIIII"
+
+	headers = []
+	for i in range(shnum):
+		start = shoff + i * shentsize
+		headers.append(struct.unpack(shdr, elf[start:start + struct.calcsize(shdr)]))
+
+	names = headers[shstrndx]
+	sections = {}
+	for (name, type, flags, addr, offset, size, link, info, align, entsize) in headers:
+		name = elf[names[4] + name:].split(b"\0", 1)[0].decode("latin-1")
+		data = elf[offset:offset + size] if type != 8 else b""	# SHT_NOBITS
+		sections[name] = (addr, flags, data)
+
+	return sections, end
+
+def read_trace(path, end):
+	fd = open(path, "rb")
+	raw = fd.read()
+	fd.close()
+
+	lines = re.findall(b"#T((?: [0-9a-f]{8})+)", raw)
+	if lines:
+		return [int(w, 16) for l in lines for w in l.split()]
+
+	count = len(raw) // 4
+	return list(struct.unpack(end + "%dI" % count, raw[:count * 4]))
+
+def cstring(data, offset):
+	return data[offset:].split(b"\0", 1)[0].decode("latin-1")
+
+def lookup_string(sections, addr):
+	for (start, flags, data) in sections.values():
+		# SHF_ALLOC
+		if (flags & 2) and start <= addr < start + len(data):
+			return cstring(data, addr - start)
+	return "<0x%x>" % addr
+
+# The same conversions as dbg_log()
+def format_message(fmt, args, sections):
+	out = ""
+	i = 0
+	while i < len(fmt):
+		if fmt[i] != "%":
+			out += fmt[i]
+			i += 1
+			continue
+		conv = fmt[i + 1:i + 2]
+		i += 2
+		if conv == "%":
+			out += "%"
+		elif conv in ("d", "i", "u", "x"):
+			out += "0x%x" % args.pop(0)
+		elif conv == "s":
+			out += lookup_string(sections, args.pop(0))
+		elif conv == "c":
+			out += chr(args.pop(0) & 0xff)
+		else:
+			out += "%" + conv
+	return out
+
+def main():
+	if len(sys.argv) != 3:
+		sys.exit("usage: %s <elf> <trace>" % sys.argv[0])
+
+	sections, end = read_sections(sys.argv[1])
+	if ".dbg_fmt" not in sections:
+		sys.exit("%s: no .dbg_fmt section, not a trace build" % sys.argv[1])
+	fmt_addr, flags, fmt_data = sections[".dbg_fmt"]
+
+	words = read_trace(sys.argv[2], end)
+	if len(words) < 3 or words[0] != TRACE_MAGIC:
+		sys.exit("%s: no trace found" % sys.argv[2])
+
+	length, lost = words[1], words[2]
+	log = words[3:3 + length]
+
+	i = 0
+	while i < len(log):
+		nargs = log[i] >> 24
+		fmt = cstring(fmt_data, (log[i] & 0xffffff) - fmt_addr)
+		sys.stdout.write(format_message(fmt, log[i + 1:i + 1 + nargs], sections))
+		i += 1 + nargs
+
+	if lost:
+		sys.stdout.write("\n[%d messages lost, trace buffer full]\n" % lost)
+
+if __name__ == "__main__":
+	main()
@@ -21,6 +21,16 @@ ifeq ($(CONFIG_DEBUG),y)
 CPPFLAGS += -DCONFIG_DEBUG
 endif
 
+ifeq ($(CONFIG_DEBUG_TRACE),y)
+CPPFLAGS += -DCONFIG_DEBUG_TRACE
+CPPFLAGS += -DDEBUG_TRACE_SIZE=$(DEBUG_TRACE_SIZE)
+CPPFLAGS += -DDEBUG_TRACE_ADDR=$(DEBUG_TRACE_ADDR)
+endif
+
+ifeq ($(CONFIG_DEBUG_TRACE_DUMP),y)
+CPPFLAGS += -DCONFIG_DEBUG_TRACE_DUMP
+endif
+
 ifeq ($(CONFIG_HW_INIT),y)
 CPPFLAGS += -DCONFIG_HW_INIT
 endif